@@ -0,0 +1,22 @@
+#include <cstdlib>
+#include <new>
+#include "allocation_counter.hpp"
+
+void* operator new(std::size_t size)
+{
+    allocation_counter::allocations.fetch_add(1, std::memory_order_relaxed);
+    allocation_counter::bytes.fetch_add(size, std::memory_order_relaxed);
+    if (void* ptr = std::malloc(size == 0 ? 1 : size))
+    {
+        return ptr;
+    }
+    throw std::bad_alloc{};
+}
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+void operator delete(void* ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
@@ -0,0 +1,34 @@
+#ifndef ALLOCATION_COUNTER_HPP
+#define ALLOCATION_COUNTER_HPP
+
+#include <benchmark/benchmark.h>
+#include <atomic>
+#include <cstddef>
+
+namespace allocation_counter
+{
+    // Incremented by the global operator new replacement in allocation_counter.cpp
+    inline std::atomic<size_t> allocations{0};
+    inline std::atomic<size_t> bytes{0};
+
+    // Reports the allocations made inside the benchmark loop as per-iteration counters.
+    class Scope
+    {
+        benchmark::State& m_state;
+        size_t m_allocations{allocations.load()};
+        size_t m_bytes{bytes.load()};
+
+    public:
+        explicit Scope(benchmark::State& state)
+            : m_state{state}
+        {
+        }
+        ~Scope()
+        {
+            auto per_iteration = benchmark::Counter::kAvgIterations;
+            m_state.counters["allocs_per_op"] = benchmark::Counter(static_cast<double>(allocations.load() - m_allocations), per_iteration);
+            m_state.counters["bytes_per_op"]  = benchmark::Counter(static_cast<double>(bytes.load() - m_bytes), per_iteration);
+        }
+    };
+}
+#endif
@@ -0,0 +1,86 @@
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+#include "parameter_parser/reader.hpp"
+#include "synthetic.hpp"
+
+using parameter_parser::reader::FrozenIndex;
+
+namespace
+{
+    struct Keys
+    {
+        std::vector<std::string> storage{};
+        ParameterMap map{};
+        std::vector<str_v> shuffled{};
+
+        explicit Keys(size_t count)
+        {
+            storage.reserve(count);
+            for (size_t i = 0; i < count; i++)
+            {
+                storage.push_back(synthetic::key(i));
+            }
+            for (const auto& key : storage)
+            {
+                map.emplace(key, key);
+            }
+            shuffled = {storage.begin(), storage.end()};
+            std::ranges::shuffle(shuffled, std::mt19937{42});
+        }
+    };
+
+    void BM_UnorderedMapLookup(benchmark::State& state)
+    {
+        Keys keys{static_cast<size_t>(state.range(0))};
+        size_t i = 0;
+        for (auto _ : state)
+        {
+            auto it = keys.map.find(keys.shuffled[i++ % keys.shuffled.size()]);
+            benchmark::DoNotOptimize(it);
+        }
+    }
+    void BM_FrozenIndexLookup(benchmark::State& state)
+    {
+        Keys keys{static_cast<size_t>(state.range(0))};
+        auto index = FrozenIndex::build(keys.map);
+        size_t i   = 0;
+        for (auto _ : state)
+        {
+            auto value = index.find(keys.shuffled[i++ % keys.shuffled.size()]);
+            benchmark::DoNotOptimize(value);
+        }
+    }
+    void BM_FrozenIndexBuild(benchmark::State& state)
+    {
+        Keys keys{static_cast<size_t>(state.range(0))};
+        for (auto _ : state)
+        {
+            auto index = FrozenIndex::build(keys.map);
+            benchmark::DoNotOptimize(index);
+        }
+    }
+    // Every key of one of the 97 sections of synthetic::key, eg: all of "section_42.*".
+    void BM_FrozenIndexPrefix(benchmark::State& state)
+    {
+        Keys keys{static_cast<size_t>(state.range(0))};
+        auto index   = FrozenIndex::build(keys.map);
+        size_t found = 0;
+        for (auto _ : state)
+        {
+            for (const auto& entry : index.with_prefix("section_42."))
+            {
+                benchmark::DoNotOptimize(entry);
+                found++;
+            }
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(found));
+    }
+}
+
+BENCHMARK(BM_UnorderedMapLookup)->Arg(10)->Arg(1'000)->Arg(1'000'000);
+BENCHMARK(BM_FrozenIndexLookup)->Arg(10)->Arg(1'000)->Arg(1'000'000);
+BENCHMARK(BM_FrozenIndexPrefix)->Arg(1'000)->Arg(1'000'000);
+BENCHMARK(BM_FrozenIndexBuild)->Arg(10)->Arg(1'000)->Arg(1'000'000)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,162 @@
+#include <benchmark/benchmark.h>
+#include <filesystem>
+#include <memory_resource>
+#include <optional>
+#include <random>
+#include <string>
+#include <vector>
+#include "parameter_parser/reader.hpp"
+#include "allocation_counter.hpp"
+#include "synthetic.hpp"
+
+using parameter_parser::reader::Load;
+using parameter_parser::reader::Mode;
+using parameter_parser::reader::ParameterReader;
+
+namespace
+{
+    auto build_or_skip(benchmark::State& state, size_t lines) -> std::optional<ParameterReader>
+    {
+        auto reader = ParameterReader::build(synthetic::parameter_file(lines).string(), "=>");
+        if (!reader)
+        {
+            state.SkipWithError("could not build the synthetic parameter file");
+            return {};
+        }
+        return std::move(reader.value());
+    }
+    auto shuffled_keys(size_t lines, size_t count, bool hits) -> std::vector<std::string>
+    {
+        std::mt19937 gen{7};
+        std::uniform_int_distribution<size_t> dist{0, lines - 1};
+        std::vector<std::string> keys{};
+        for (size_t i = 0; i < count; i++)
+        {
+            size_t integer_line = dist(gen) / 4 * 4; // every 4th line holds an integer
+            keys.push_back(synthetic::key(hits ? integer_line : lines + integer_line));
+        }
+        return keys;
+    }
+
+    void BM_Build(benchmark::State& state)
+    {
+        auto lines = static_cast<size_t>(state.range(0));
+        auto path  = synthetic::parameter_file(lines).string();
+        auto load  = state.range(1) ? Load::Mapped : Load::Buffered;
+        auto bytes = std::filesystem::file_size(path);
+        allocation_counter::Scope allocations{state};
+        for (auto _ : state)
+        {
+            auto reader = ParameterReader::build(path, "=>", Mode::Strict, load);
+            benchmark::DoNotOptimize(reader);
+        }
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * bytes));
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * lines));
+    }
+    void BM_BuildArena(benchmark::State& state)
+    {
+        auto lines = static_cast<size_t>(state.range(0));
+        auto path  = synthetic::parameter_file(lines).string();
+        allocation_counter::Scope allocations{state};
+        for (auto _ : state)
+        {
+            std::pmr::monotonic_buffer_resource arena{};
+            auto reader = ParameterReader::build(path, "=>", Mode::Strict, Load::Buffered, &arena);
+            benchmark::DoNotOptimize(reader);
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * lines));
+    }
+    void BM_BuildParallel(benchmark::State& state)
+    {
+        auto lines = static_cast<size_t>(state.range(0));
+        auto path  = synthetic::parameter_file(lines).string();
+        for (auto _ : state)
+        {
+            auto reader = ParameterReader::build_parallel(path, "=>", static_cast<size_t>(state.range(1)));
+            benchmark::DoNotOptimize(reader);
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * lines));
+    }
+
+    void lookup(benchmark::State& state, bool hits)
+    {
+        auto lines  = static_cast<size_t>(state.range(0));
+        auto reader = build_or_skip(state, lines);
+        if (!reader)
+        {
+            return;
+        }
+        if (state.range(1))
+        {
+            reader->freeze();
+        }
+        auto keys = shuffled_keys(lines, 4096, hits);
+        size_t i  = 0;
+        allocation_counter::Scope allocations{state};
+        for (auto _ : state)
+        {
+            auto value = reader->try_parse_num<int64_t>(keys[i++ % keys.size()]);
+            benchmark::DoNotOptimize(value);
+        }
+    }
+    void BM_LookupHit(benchmark::State& state)
+    {
+        lookup(state, true);
+    }
+    void BM_LookupMiss(benchmark::State& state)
+    {
+        lookup(state, false);
+    }
+
+    void BM_ParseNum(benchmark::State& state)
+    {
+        auto reader = build_or_skip(state, 1'000);
+        if (!reader)
+        {
+            return;
+        }
+        auto key = synthetic::key(1); // a double
+        allocation_counter::Scope allocations{state};
+        for (auto _ : state)
+        {
+            auto value = reader->try_parse_num<double>(key);
+            benchmark::DoNotOptimize(value);
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+    }
+    void BM_ParseError(benchmark::State& state)
+    {
+        auto reader = build_or_skip(state, 1'000);
+        if (!reader)
+        {
+            return;
+        }
+        auto key = synthetic::key(2); // a string
+        allocation_counter::Scope allocations{state};
+        for (auto _ : state)
+        {
+            if (state.range(0))
+            {
+                auto value = reader->try_parse_vector<double>(key, ",");
+                benchmark::DoNotOptimize(value);
+            }
+            else
+            {
+                auto value = reader->try_parse_num<double>(key);
+                benchmark::DoNotOptimize(value);
+            }
+        }
+    }
+}
+
+// {lines, 0: buffered / 1: mapped}
+BENCHMARK(BM_Build)->ArgsProduct({{10, 1'000, 100'000, 1'000'000, 10'000'000}, {0, 1}})->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_BuildArena)->Arg(1'000)->Arg(100'000)->Arg(1'000'000)->Unit(benchmark::kMillisecond);
+// {lines, threads}
+BENCHMARK(BM_BuildParallel)->ArgsProduct({{1'000'000, 10'000'000}, {2, 4, 8}})->Unit(benchmark::kMillisecond)->UseRealTime();
+// {lines, 0: unordered_map / 1: frozen}
+BENCHMARK(BM_LookupHit)->ArgsProduct({{10, 1'000, 1'000'000}, {0, 1}});
+BENCHMARK(BM_LookupMiss)->ArgsProduct({{10, 1'000, 1'000'000}, {0, 1}});
+BENCHMARK(BM_ParseNum);
+// 0: number / 1: vector
+BENCHMARK(BM_ParseError)->Arg(0)->Arg(1);
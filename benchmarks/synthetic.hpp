@@ -0,0 +1,62 @@
+#ifndef SYNTHETIC_HPP
+#define SYNTHETIC_HPP
+
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+
+namespace synthetic
+{
+    inline auto key(size_t i) -> std::string
+    {
+        return "section_" + std::to_string(i % 97) + ".parameter_" + std::to_string(i);
+    }
+
+    inline auto float_list(size_t count, const char* delim = ", ") -> std::string
+    {
+        std::mt19937 gen{42};
+        std::uniform_real_distribution<float> dist{-1000.0f, 1000.0f};
+        std::string list{};
+        for (size_t i = 0; i < count; i++)
+        {
+            list += std::to_string(dist(gen));
+            list += (i + 1 < count) ? delim : "";
+        }
+        return list;
+    }
+
+    // Writes (once per size) a parameter file mixing ints, doubles, strings and short vectors.
+    inline auto parameter_file(size_t lines) -> std::filesystem::path
+    {
+        auto path = std::filesystem::temp_directory_path() / ("parameter_parser_bench_" + std::to_string(lines) + ".txt");
+        if (std::filesystem::exists(path))
+        {
+            return path;
+        }
+        std::ofstream file{path};
+        for (size_t i = 0; i < lines; i++)
+        {
+            file << key(i) << " => ";
+            switch (i % 4)
+            {
+            case 0:
+                file << i;
+                break;
+            case 1:
+                file << i * 0.25;
+                break;
+            case 2:
+                file << "value number " << i;
+                break;
+            default:
+                file << i << ", " << i + 1 << ", " << i + 2;
+                break;
+            }
+            file << '\n';
+        }
+        return path;
+    }
+}
+#endif
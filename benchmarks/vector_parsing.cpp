@@ -0,0 +1,39 @@
+#include <benchmark/benchmark.h>
+#include <random>
+#include <string>
+#include <vector>
+#include "parameter_parser/utilities.hpp"
+#include "allocation_counter.hpp"
+#include "synthetic.hpp"
+
+namespace
+{
+    void BM_TryParseVec(benchmark::State& state)
+    {
+        auto list = synthetic::float_list(static_cast<size_t>(state.range(0)));
+        allocation_counter::Scope allocations{state};
+        for (auto _ : state)
+        {
+            auto values = parameter_parser::utilities::try_parse_vec<float>(list, ",");
+            benchmark::DoNotOptimize(values);
+        }
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * list.size()));
+    }
+    void BM_TryParseVecIntoReused(benchmark::State& state)
+    {
+        auto list = synthetic::float_list(static_cast<size_t>(state.range(0)));
+        std::vector<float> values{};
+        allocation_counter::Scope allocations{state};
+        for (auto _ : state)
+        {
+            values.clear();
+            auto count = parameter_parser::utilities::try_parse_vec_into<float>(list, ",", values);
+            benchmark::DoNotOptimize(count);
+        }
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * list.size()));
+    }
+}
+
+// bytes_per_second is the tracked throughput figure
+BENCHMARK(BM_TryParseVec)->Arg(10)->Arg(1'000)->Arg(1'000'000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_TryParseVecIntoReused)->Arg(10)->Arg(1'000)->Arg(1'000'000)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,66 @@
+#include <benchmark/benchmark.h>
+#include <iomanip>
+#include <limits>
+#include <random>
+#include <sstream>
+#include <vector>
+#include "parameter_parser/writer.hpp"
+
+namespace
+{
+    // 100 keys holding 1000 doubles each, written so that they read back exactly.
+    auto result_vectors() -> std::vector<std::vector<double>>
+    {
+        std::mt19937 gen{42};
+        std::uniform_real_distribution<double> dist{-1000.0, 1000.0};
+        std::vector<std::vector<double>> vectors(100, std::vector<double>(1000));
+        for (auto& values : vectors)
+        {
+            std::ranges::generate(values, [&]{return dist(gen);});
+        }
+        return vectors;
+    }
+
+    void BM_WriteVectorsOstream(benchmark::State& state)
+    {
+        auto vectors = result_vectors();
+        for (auto _ : state)
+        {
+            std::ostringstream out{};
+            out << std::setprecision(std::numeric_limits<double>::max_digits10);
+            for (size_t k = 0; k < vectors.size(); k++)
+            {
+                out << "result_" << k << " => ";
+                for (size_t i = 0; i < vectors[k].size(); i++)
+                {
+                    out << (i > 0 ? ", " : "") << vectors[k][i];
+                }
+                out << '\n';
+            }
+            benchmark::DoNotOptimize(out.view().data());
+        }
+        state.SetItemsProcessed(state.iterations() * 100 * 1000);
+    }
+    void BM_WriteVectorsWriter(benchmark::State& state)
+    {
+        auto vectors = result_vectors();
+        std::vector<std::string> keys{};
+        for (size_t k = 0; k < vectors.size(); k++)
+        {
+            keys.push_back("result_" + std::to_string(k));
+        }
+        for (auto _ : state)
+        {
+            parameter_parser::writer::ParameterWriter out{"=>"};
+            for (size_t k = 0; k < vectors.size(); k++)
+            {
+                out.write_vector(keys[k], vectors[k], ", ");
+            }
+            benchmark::DoNotOptimize(out.view().data());
+        }
+        state.SetItemsProcessed(state.iterations() * 100 * 1000);
+    }
+}
+
+BENCHMARK(BM_WriteVectorsOstream)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_WriteVectorsWriter)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,81 @@
+#ifndef PARAMETER_BATCH_HPP
+#define PARAMETER_BATCH_HPP
+
+#include <array>
+#include <expected>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "parameter_parser/reader_error.hpp"
+#include "parameter_parser/schema.hpp"
+
+namespace parameter_parser::reader
+{
+    // One entry of a batch lookup, see ParameterReader::try_resolve.
+    template<BindableMember T>
+    struct Request
+    {
+        using value_type = T;
+        str_v key{};
+        str_v delim{};
+    };
+
+    template<utilities::Parsable T>
+    auto value(str_v key) -> Request<T>
+    {
+        return Request<T>{.key = key};
+    }
+    template<utilities::Number T>
+    auto num(str_v key) -> Request<T>
+    {
+        return value<T>(key);
+    }
+    template<utilities::Parsable T>
+    auto vec(str_v key, str_v delim) -> Request<std::vector<T>>
+    {
+        return Request<std::vector<T>>{.key = key, .delim = delim};
+    }
+    inline auto str(str_v key) -> Request<std::string>
+    {
+        return Request<std::string>{.key = key};
+    }
+
+    // Resolves every key first (one probe each, back to back), then parses the values,
+    // and collects the errors of all requests instead of stopping at the first. A ParseError reads "<key>: <bad value>".
+    template<typename Find, typename... Ts>
+    auto resolve(Find&& find, const Request<Ts>&... requests) -> std::expected<std::tuple<Ts...>, std::vector<ReaderError>>
+    {
+        std::array<const str_v*, sizeof...(Ts)> values{find(requests.key)...};
+
+        std::vector<ReaderError> errors{};
+        auto parse_one = [&]<typename T>(const Request<T>& request, const str_v* value) -> T
+        {
+            if (value == nullptr)
+            {
+                errors.push_back(ReaderError{.args = std::string{request.key}, .from = ReaderError::From::try_resolve, .kind = ReaderError::Kind::KeyError});
+                return T{};
+            }
+            auto parsed = parse_as<T>(*value, request.delim);
+            if (!parsed)
+            {
+                errors.push_back(ReaderError{.args = std::string{request.key} + ": " + parsed.error(), .from = ReaderError::From::try_resolve, .kind = ReaderError::Kind::ParseError});
+                return T{};
+            }
+            return std::move(parsed.value());
+        };
+        auto results = [&]<size_t... I>(std::index_sequence<I...>)
+        {
+            return std::tuple<Ts...>{parse_one(requests, values[I])...}; // braced init: evaluated in request order
+        }(std::index_sequence_for<Ts...>{});
+
+        if (!errors.empty())
+        {
+            return std::unexpected(std::move(errors));
+        }
+        return results;
+    }
+}
+#endif
@@ -0,0 +1,227 @@
+#ifndef BINARY_CACHE_HPP
+#define BINARY_CACHE_HPP
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <expected>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "parameter_parser/reader.hpp"
+#include "parameter_parser/reader_error.hpp"
+#include "parameter_parser/source_buffer.hpp"
+
+namespace parameter_parser::reader
+{
+    enum class CacheCheck
+    {
+        Metadata, // source size and modification time
+        Full,     // also the FNV-1a hash of the source bytes (reads the source)
+    };
+
+    // Compact binary snapshot of a built reader, loaded by memory-mapping it: the reader's views then point straight
+    // into the mapping, so startup costs page faults instead of a text parse.
+    // Layout (host endianness): Header | Entry[entry_count] | delimiter | key/value bytes.
+    // Caches are tied to the source file (size, mtime, hash) and to the delimiter and mode used to parse it.
+    class BinaryCache
+    {
+        static constexpr std::array<char, 8> magic{'P', 'P', 'C', 'A', 'C', 'H', 'E', '1'};
+
+        struct Header
+        {
+            std::array<char, 8> magic{};
+            uint64_t source_size{};
+            int64_t source_mtime{};
+            uint64_t source_hash{};
+            uint64_t entry_count{};
+            uint32_t delimiter_length{};
+            uint32_t mode{};
+        };
+        struct Entry
+        {
+            uint64_t key_offset{};
+            uint64_t value_offset{};
+            uint32_t key_length{};
+            uint32_t value_length{};
+        };
+
+        static auto fnv1a(str_v bytes) -> uint64_t
+        {
+            uint64_t hash = 0xcbf29ce484222325ull;
+            for (char c : bytes)
+            {
+                hash = (hash ^ static_cast<unsigned char>(c)) * 0x100000001b3ull;
+            }
+            return hash;
+        }
+        template<typename T>
+        static auto read_at(str_v bytes, size_t offset) -> std::optional<T>
+        {
+            if (offset > bytes.size() || bytes.size() - offset < sizeof(T))
+            {
+                return {};
+            }
+            T value{};
+            std::memcpy(&value, bytes.data() + offset, sizeof(T));
+            return value;
+        }
+
+    public:
+        // The source file's size and modification time, taken before the source is read: a cache then never pairs
+        // metadata of a newer file with the content of an older one.
+        struct SourceStamp
+        {
+            uint64_t size{};
+            int64_t mtime{};
+        };
+        static auto stamp(const std::string& source_path) -> std::optional<SourceStamp>
+        {
+            std::error_code size_ec{};
+            std::error_code mtime_ec{};
+            auto size  = std::filesystem::file_size(source_path, size_ec);
+            auto mtime = std::filesystem::last_write_time(source_path, mtime_ec);
+            if (size_ec || mtime_ec)
+            {
+                return {};
+            }
+            return SourceStamp{.size = size, .mtime = static_cast<int64_t>(mtime.time_since_epoch().count())};
+        }
+
+    private:
+        // Returns the reader stored in cache_path if it still matches the source, otherwise nothing.
+        static auto try_load(const std::string& source_path, SourceStamp source, const std::string& cache_path, str_v delimiter, Mode mode, CacheCheck check) -> std::optional<ParameterReader>
+        {
+            auto cache = SourceBuffer::map_file(cache_path.c_str());
+            if (!cache)
+            {
+                return {};
+            }
+            str_v bytes = cache->view();
+            auto header = read_at<Header>(bytes, 0);
+            if (!header || header->magic != magic || header->source_size != source.size || header->source_mtime != source.mtime || header->mode != static_cast<uint32_t>(mode))
+            {
+                return {};
+            }
+            size_t entries_offset = sizeof(Header);
+            size_t blob_offset    = entries_offset + header->entry_count * sizeof(Entry);
+            if (header->entry_count > bytes.size() / sizeof(Entry) || blob_offset > bytes.size() || header->delimiter_length > bytes.size() - blob_offset
+                || bytes.substr(blob_offset, header->delimiter_length) != delimiter)
+            {
+                return {};
+            }
+            if (check == CacheCheck::Full)
+            {
+                auto source = SourceBuffer::map_file(source_path.c_str());
+                if (!source || fnv1a(source->view()) != header->source_hash)
+                {
+                    return {};
+                }
+            }
+
+            auto buffer = std::make_shared<const SourceBuffer>(std::move(cache.value()));
+            str_v blob  = buffer->view().substr(blob_offset);
+            ParameterMap parameter_map{};
+            parameter_map.reserve(header->entry_count);
+            for (size_t i = 0; i < header->entry_count; i++)
+            {
+                Entry entry = read_at<Entry>(buffer->view(), entries_offset + i * sizeof(Entry)).value();
+                // written so that a corrupted offset near UINT64_MAX cannot wrap around
+                if (entry.key_offset > blob.size() || entry.key_length > blob.size() - entry.key_offset
+                    || entry.value_offset > blob.size() || entry.value_length > blob.size() - entry.value_offset)
+                {
+                    return {};
+                }
+                parameter_map.emplace(blob.substr(entry.key_offset, entry.key_length), blob.substr(entry.value_offset, entry.value_length));
+            }
+            ParameterReader reader{std::move(buffer), std::move(parameter_map), std::filesystem::path{source_path}.parent_path().string()};
+            reader.m_source_is_text = false; // values point into the cache blob, which has no lines to report
+            return reader;
+        }
+
+    public:
+        // Serializes reader, which must have been built with this delimiter and mode from the source file described by
+        // source, a stamp taken before the build. Readers that do not hold the text of a parameter file (loaded from a
+        // cache, flattened layers) are refused, as is a source whose size is not the stamped one.
+        // The file is written next to cache_path and renamed over it, so concurrent loaders never see a partial cache.
+        static auto write(const ParameterReader& reader, SourceStamp source, const std::string& cache_path, str_v delimiter, Mode mode) -> std::expected<void, ReaderError>
+        {
+            if (!reader.m_source || !reader.m_source_is_text || reader.m_source->view().size() != source.size)
+            {
+                ReaderError error{.args = cache_path, .from = ReaderError::From::write_cache, .kind = ReaderError::Kind::FileError};
+                return std::unexpected(error);
+            }
+            std::error_code ec{};
+
+            std::vector<Entry> entries{};
+            std::string blob{delimiter};
+            reader.for_each_entry([&](str_v key, str_v value)
+            {
+                Entry entry{.key_offset = blob.size(), .key_length = static_cast<uint32_t>(key.size())};
+                blob += key;
+                entry.value_offset = blob.size();
+                entry.value_length = static_cast<uint32_t>(value.size());
+                blob += value;
+                entries.push_back(entry);
+            });
+            Header header{
+                .magic            = magic,
+                .source_size      = source.size,
+                .source_mtime     = source.mtime,
+                .source_hash      = fnv1a(reader.m_source->view()),
+                .entry_count      = entries.size(),
+                .delimiter_length = static_cast<uint32_t>(delimiter.size()),
+                .mode             = static_cast<uint32_t>(mode),
+            };
+
+            std::string temporary_path = cache_path + ".tmp" + std::to_string(std::random_device{}());
+            {
+                std::ofstream file{temporary_path, std::ios::binary | std::ios::trunc};
+                file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+                file.write(reinterpret_cast<const char*>(entries.data()), static_cast<std::streamsize>(entries.size() * sizeof(Entry)));
+                file.write(blob.data(), static_cast<std::streamsize>(blob.size()));
+                if (!file)
+                {
+                    std::filesystem::remove(temporary_path, ec);
+                    ReaderError error{.args = cache_path, .from = ReaderError::From::write_cache, .kind = ReaderError::Kind::FileError};
+                    return std::unexpected(error);
+                }
+            }
+            std::filesystem::rename(temporary_path, cache_path, ec);
+            if (ec)
+            {
+                std::filesystem::remove(temporary_path, ec);
+                ReaderError error{.args = cache_path, .from = ReaderError::From::write_cache, .kind = ReaderError::Kind::FileError};
+                return std::unexpected(error);
+            }
+            return {};
+        }
+
+        // Loads cache_path when it matches source_path; otherwise builds from source_path with the regular build
+        // and refreshes the cache (a failure to write the cache does not fail the build).
+        static auto build(const std::string& source_path, const std::string& cache_path, str_v delimiter, Mode mode = Mode::Strict, CacheCheck check = CacheCheck::Metadata) -> std::expected<ParameterReader, ReaderError>
+        {
+            auto source = stamp(source_path);
+            if (!source)
+            {
+                return ParameterReader::build(source_path, delimiter, mode);
+            }
+            if (auto cached = try_load(source_path, source.value(), cache_path, delimiter, mode, check))
+            {
+                return std::move(cached.value());
+            }
+            auto built = ParameterReader::build(source_path, delimiter, mode);
+            if (built)
+            {
+                [[maybe_unused]] auto written = write(built.value(), source.value(), cache_path, delimiter, mode);
+            }
+            return built;
+        }
+    };
+}
+#endif
@@ -0,0 +1,289 @@
+#ifndef PARAMETER_EMBEDDED_HPP
+#define PARAMETER_EMBEDDED_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "parameter_parser/frozen_index.hpp"
+#include "parameter_parser/mode.hpp"
+#include "parameter_parser/reader_error.hpp"
+#include "parameter_parser/utilities.hpp"
+
+namespace parameter_parser::reader
+{
+    using utilities::FixedString;
+
+    // A parameter file parsed by the compiler, from a string literal or a null-terminated array filled by #embed, eg:
+    //     constexpr char text[] = {
+    //     #embed "parameters.txt"
+    //     , '\0'};
+    //     using Params = EmbeddedParameters<text, "=>">;
+    //     constexpr double tol = Params::num<double, "tol">;          // a constant: nothing is built or parsed at startup
+    //     constexpr auto axis  = Params::array<float, "axis", ",">;  // std::array<float, 3>
+    // Lines are read as ParameterReader::build reads them, "[section]" headers included, and the first occurrence of a key
+    // wins. A malformed line (Strict mode), a missing key or a bad number is a compile error. Keys only known at run time
+    // go through find(), a binary search over the key hashes.
+    template<FixedString Text, FixedString Delimiter = "=>", Mode FileMode = Mode::Strict>
+    class EmbeddedParameters
+    {
+    public:
+        using Entry = FrozenIndex::Entry;
+
+    private:
+        static constexpr str_v text      = Text.view();
+        static constexpr str_v delimiter = Delimiter.view();
+
+        // Calls visit(section, key, value) for each entry, like ParameterReader::parse_lines. Returns the first
+        // malformed line in Strict mode.
+        template<typename F>
+        static constexpr auto for_each_line(F&& visit) -> std::optional<str_v>
+        {
+            str_v section{};
+            str_v remaining = text;
+            while (!remaining.empty())
+            {
+                size_t end = std::min(remaining.find('\n'), remaining.length());
+                str_v line = remaining.substr(0, end);
+                remaining.remove_prefix(std::min(end + 1, remaining.length()));
+
+                if (auto key_val = utilities::split_once(line, delimiter); key_val.has_value())
+                {
+                    auto[key, value] = key_val.value();
+                    visit(section, utilities::trim(key), utilities::trim(value));
+                }
+                else if (auto header = utilities::section_header(line, delimiter); header.has_value()) // never holds the delimiter
+                {
+                    section = header.value();
+                }
+                else if (FileMode == Mode::Strict)
+                {
+                    return line;
+                }
+            }
+            return {};
+        }
+
+        struct Counts
+        {
+            size_t entries{};
+            size_t section_key_chars{};
+            std::optional<str_v> malformed{};
+        };
+        static constexpr Counts counts = []
+        {
+            Counts line_counts{};
+            line_counts.malformed = for_each_line([&](str_v section, str_v key, str_v)
+            {
+                line_counts.entries++;
+                line_counts.section_key_chars += section.empty() ? 0 : section.length() + 1 + key.length();
+            });
+            return line_counts;
+        }();
+        static_assert(!counts.malformed.has_value(), "the embedded parameter file has a line without delimiter (Strict mode)");
+
+        // The "section.key" keys, which are not slices of the text.
+        static constexpr auto section_keys = []
+        {
+            std::array<char, counts.section_key_chars> chars{};
+            size_t used = 0;
+            if (chars.empty())
+            {
+                return chars;
+            }
+            for_each_line([&](str_v section, str_v key, str_v)
+            {
+                if (!section.empty())
+                {
+                    used        = static_cast<size_t>(std::ranges::copy(section, chars.begin() + used).out - chars.begin());
+                    chars[used] = '.';
+                    used        = static_cast<size_t>(std::ranges::copy(key, chars.begin() + used + 1).out - chars.begin());
+                }
+            });
+            return chars;
+        }();
+
+        static constexpr auto fnv1a(str_v bytes) -> uint64_t
+        {
+            uint64_t hash = 0xcbf29ce484222325ull;
+            for (char c : bytes)
+            {
+                hash = (hash ^ static_cast<unsigned char>(c)) * 0x100000001b3ull;
+            }
+            return hash;
+        }
+
+        // The entries ordered by key hash: sorting integers keeps the compiler well under its constexpr operation limit
+        // where comparing thousands of keys with a common prefix would not. Of duplicate keys the first occurrence is kept.
+        static constexpr auto hashed = []
+        {
+            std::array<std::pair<uint64_t, uint32_t>, counts.entries> order{};
+            std::array<Entry, counts.entries> all{};
+            size_t count = 0;
+            size_t used  = 0;
+            for_each_line([&](str_v section, str_v key, str_v value)
+            {
+                if (!section.empty())
+                {
+                    key   = str_v{section_keys.data() + used, section.length() + 1 + key.length()};
+                    used += key.length();
+                }
+                order[count] = std::pair{fnv1a(key), static_cast<uint32_t>(count)};
+                all[count++] = Entry{.key = key, .value = value};
+            });
+            std::sort(order.begin(), order.end(), [](const auto& a, const auto& b) // far cheaper to evaluate than pair's <=>
+            {
+                return a.first < b.first || (a.first == b.first && a.second < b.second);
+            });
+
+            std::array<std::pair<uint64_t, Entry>, counts.entries> unique{};
+            size_t size = 0;
+            for (auto [hash, index] : order)
+            {
+                bool duplicate = false;
+                for (size_t previous = size; previous-- > 0 && unique[previous].first == hash;)
+                {
+                    duplicate = duplicate || unique[previous].second.key == all[index].key;
+                }
+                if (!duplicate)
+                {
+                    unique[size++] = std::pair{hash, all[index]};
+                }
+            }
+            return std::pair{unique, size};
+        }();
+        static constexpr auto hashes = []
+        {
+            std::array<uint64_t, hashed.second> keys{};
+            std::ranges::transform(hashed.first.begin(), hashed.first.begin() + hashed.second, keys.begin(), &std::pair<uint64_t, Entry>::first);
+            return keys;
+        }();
+        static constexpr auto table = []
+        {
+            std::array<Entry, hashed.second> unique{};
+            std::ranges::transform(hashed.first.begin(), hashed.first.begin() + hashed.second, unique.begin(), &std::pair<uint64_t, Entry>::second);
+            return unique;
+        }();
+
+        template<FixedString Key>
+        static consteval auto value_of() -> str_v
+        {
+            static_assert(contains(Key.view()), "key not found in the embedded parameter file");
+            return *find(Key.view());
+        }
+        template<typename T, FixedString Key>
+        static consteval auto parse_value() -> T
+        {
+            constexpr auto parsed = utilities::parse_num_handled<T>(value_of<Key>());
+            static_assert(parsed.has_value(), "the value of this key is not a number");
+            return parsed.value();
+        }
+        template<typename T, FixedString Key, FixedString Delim>
+        static consteval auto parse_values()
+        {
+            constexpr auto parsed = []
+            {
+                std::array<T, utilities::count_tokens(value_of<Key>(), Delim.view())> values{};
+                size_t count = 0;
+                bool valid   = true;
+                utilities::for_each_token(value_of<Key>(), Delim.view(), [&](str_v token, size_t)
+                {
+                    auto value      = utilities::parse_num_handled<T>(token);
+                    valid           = valid && value.has_value();
+                    values[count++] = value.value_or(T{});
+                });
+                return std::pair{valid, values};
+            }();
+            static_assert(parsed.first, "a token of the value of this key is not a number");
+            return parsed.second;
+        }
+        static auto error_source() -> ErrorSource
+        {
+            return ErrorSource{.owner = nullptr, .text = text};
+        }
+
+    public:
+        static constexpr auto entries() -> std::span<const Entry>
+        {
+            return table;
+        }
+        static constexpr auto size() -> size_t
+        {
+            return table.size();
+        }
+        static constexpr auto find(str_v key) -> const str_v*
+        {
+            uint64_t hash = fnv1a(key);
+            for (auto it = std::ranges::lower_bound(hashes, hash); it != hashes.end() && *it == hash; ++it)
+            {
+                if (const Entry& entry = table[static_cast<size_t>(it - hashes.begin())]; entry.key == key)
+                {
+                    return &entry.value;
+                }
+            }
+            return nullptr;
+        }
+        static constexpr auto contains(str_v key) -> bool
+        {
+            return find(key) != nullptr;
+        }
+
+        // Compile-time lookups: each is a constant, and a missing key or malformed value does not compile.
+        template<FixedString Key>
+        static constexpr str_v str = value_of<Key>();
+        template<typename T, FixedString Key>
+            requires std::is_integral_v<T> || std::is_floating_point_v<T>
+        static constexpr T num = parse_value<T, Key>();
+        template<typename T, FixedString Key, FixedString Delim = ",">
+            requires std::is_integral_v<T> || std::is_floating_point_v<T>
+        static constexpr auto array = parse_values<T, Key, Delim>();
+
+        // Run-time keys, with the errors of the ParameterReader accessors.
+        template<typename T>
+        static auto try_parse_num(str_v key) -> std::expected<T, ReaderError>
+            requires std::is_integral_v<T> || std::is_floating_point_v<T>
+        {
+            const str_v* value = find(key);
+            if (value == nullptr)
+            {
+                ReaderError error{.args = std::string{key}, .from = ReaderError::From::try_parse_num, .kind = ReaderError::Kind::KeyError};
+                return std::unexpected(error);
+            }
+            return utilities::parse_num_handled<T>(*value).transform_error([](str_v bad)
+            {
+                return ReaderError{.args = ErrorArgs::slice(bad), .from = ReaderError::From::try_parse_num, .kind = ReaderError::Kind::ParseError, .source = error_source()};
+            });
+        }
+        static auto try_get_str(str_v key) -> std::expected<str_v, ReaderError>
+        {
+            const str_v* value = find(key);
+            if (value == nullptr)
+            {
+                ReaderError error{.args = std::string{key}, .from = ReaderError::From::try_parse_str, .kind = ReaderError::Kind::KeyError};
+                return std::unexpected(error);
+            }
+            return *value;
+        }
+        template<typename SchemaT>
+        static auto try_bind() -> std::expected<typename SchemaT::value_type, std::vector<ReaderError>>
+        {
+            return SchemaT::bind([](auto&& visitor)
+            {
+                for (const Entry& entry : table)
+                {
+                    visitor(entry.key, entry.value);
+                }
+            });
+        }
+    };
+}
+#endif
@@ -0,0 +1,220 @@
+#ifndef PARAMETER_EXTERNAL_ARRAY_HPP
+#define PARAMETER_EXTERNAL_ARRAY_HPP
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <filesystem>
+#include <functional>
+#include <map>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include "parameter_parser/matrix.hpp"
+#include "parameter_parser/source_buffer.hpp"
+#include "parameter_parser/utilities.hpp"
+
+namespace parameter_parser::utilities
+{
+    // Element type of a raw binary array file, stored in native byte order.
+    enum class DType
+    {
+        i8, u8, i16, u16, i32, u32, i64, u64, f32, f64,
+    };
+    inline constexpr std::array<str_v, 10> dtype_names{"i8", "u8", "i16", "u16", "i32", "u32", "i64", "u64", "f32", "f64"};
+
+    inline auto dtype_from_str(str_v name) -> std::optional<DType>
+    {
+        for (size_t i = 0; i < dtype_names.size(); i++)
+        {
+            if (dtype_names[i] == name)
+            {
+                return static_cast<DType>(i);
+            }
+        }
+        return {};
+    }
+    template<typename T>
+    constexpr auto dtype_of() -> std::optional<DType>
+    {
+        if constexpr (std::is_floating_point_v<T>)
+        {
+            return sizeof(T) == 4 ? std::optional{DType::f32} : sizeof(T) == 8 ? std::optional{DType::f64} : std::nullopt;
+        }
+        else if constexpr (std::is_integral_v<T> && !std::is_same_v<T, bool>)
+        {
+            constexpr size_t index = 2 * static_cast<size_t>(std::countr_zero(sizeof(T))) + (std::is_unsigned_v<T> ? 1 : 0);
+            return index < 8 ? std::optional{static_cast<DType>(index)} : std::nullopt;
+        }
+        else
+        {
+            return std::nullopt;
+        }
+    }
+
+    // A value of the form "@path", "@path:dtype" and/or "@path[rows]" / "@path[rows, cols]", eg: "@weights.f32[1000, 3]".
+    // Without ":dtype", an extension naming a dtype (".f32", ".i64", ...) gives it.
+    struct ArrayRef
+    {
+        str_v path{};
+        std::optional<DType> dtype{};
+        std::optional<MatrixShape> shape{}; // "[n]" is n x 1
+    };
+
+    inline auto is_array_ref(str_v value) -> bool
+    {
+        return trim(value).starts_with('@');
+    }
+    // On failure returns the malformed part of value.
+    inline auto parse_array_ref(str_v value) -> expected<ArrayRef, str_v>
+    {
+        value = trim(value);
+        if (!value.starts_with('@'))
+        {
+            return std::unexpected(value);
+        }
+        ArrayRef ref{};
+        str_v rest = value.substr(1);
+        if (rest.ends_with(']'))
+        {
+            size_t open = rest.rfind('[');
+            if (open == str_v::npos)
+            {
+                return std::unexpected(value);
+            }
+            str_v dims = rest.substr(open + 1, rest.length() - open - 2);
+            std::array<size_t, 2> extents{1, 1};
+            size_t count = 0;
+            bool bad     = false;
+            for_each_token(dims, ","sv, [&](str_v token, size_t)
+            {
+                auto extent = parse_num_handled<size_t>(token);
+                bad |= !extent.has_value() || token.empty() || count == extents.size();
+                if (!bad)
+                {
+                    extents[count++] = extent.value();
+                }
+            });
+            if (bad || count == 0)
+            {
+                return std::unexpected(rest.substr(open));
+            }
+            ref.shape = MatrixShape{.rows = extents[0], .cols = extents[1]};
+            rest      = rest.substr(0, open);
+        }
+        if (size_t colon = rest.rfind(':'); colon != str_v::npos && dtype_from_str(rest.substr(colon + 1)))
+        {
+            ref.dtype = dtype_from_str(rest.substr(colon + 1));
+            rest      = rest.substr(0, colon);
+        }
+        else if (size_t dot = rest.rfind('.'); dot != str_v::npos)
+        {
+            ref.dtype = dtype_from_str(rest.substr(dot + 1));
+        }
+        ref.path = trim(rest);
+        if (ref.path.empty())
+        {
+            return std::unexpected(value);
+        }
+        return ref;
+    }
+}
+
+namespace parameter_parser::reader
+{
+    // The binary files referenced by a reader's "@path" values, mapped on first use and kept for the reader's lifetime.
+    // Relative paths are resolved against directory. Shared by the copies of a reader; thread-safe.
+    class ArrayFiles
+    {
+        std::string m_directory{};
+        std::mutex m_mutex{};
+        std::map<std::string, SourceBuffer, std::less<>> m_mapped{}; // nodes never move, so neither do the views into them
+
+    public:
+        ArrayFiles() = default;
+        explicit ArrayFiles(std::string directory)
+            : m_directory{std::move(directory)}
+        {
+        }
+
+        auto resolve(str_v path) const -> std::string
+        {
+            std::filesystem::path file{path};
+            return (file.is_absolute() || m_directory.empty()) ? file.string() : (std::filesystem::path{m_directory} / file).string();
+        }
+        // The bytes of the file at path, or nothing when it cannot be opened.
+        auto map(const std::string& path) -> const SourceBuffer*
+        {
+            std::lock_guard lock{m_mutex};
+            if (auto it = m_mapped.find(path); it != m_mapped.end())
+            {
+                return &it->second;
+            }
+            auto buffer = SourceBuffer::map_file(path.c_str());
+            if (!buffer.has_value())
+            {
+                return nullptr;
+            }
+            return &m_mapped.emplace(path, std::move(buffer.value())).first->second;
+        }
+    };
+
+    // A reader's ArrayFiles, created by its first "@path" lookup from the reader's memory resource: building a reader
+    // that never maps an array allocates nothing for them. Copies made after that lookup share the mapped files.
+    class LazyArrayFiles
+    {
+        std::pmr::string m_directory{};
+        mutable std::atomic<std::shared_ptr<ArrayFiles>> m_files{};
+
+    public:
+        LazyArrayFiles() = default;
+        LazyArrayFiles(str_v directory, std::pmr::memory_resource* resource)
+            : m_directory{directory, resource}
+        {
+        }
+        LazyArrayFiles(const LazyArrayFiles& other)
+            : m_directory{other.m_directory}, m_files{other.m_files.load(std::memory_order_acquire)}
+        {
+        }
+        LazyArrayFiles(LazyArrayFiles&& other) noexcept
+            : m_directory{std::move(other.m_directory)}, m_files{other.m_files.exchange(nullptr, std::memory_order_acq_rel)}
+        {
+        }
+        auto operator=(const LazyArrayFiles& other) -> LazyArrayFiles&
+        {
+            m_directory = other.m_directory;
+            m_files.store(other.m_files.load(std::memory_order_acquire), std::memory_order_release);
+            return *this;
+        }
+        auto operator=(LazyArrayFiles&& other) noexcept -> LazyArrayFiles&
+        {
+            m_directory = std::move(other.m_directory);
+            m_files.store(other.m_files.exchange(nullptr, std::memory_order_acq_rel), std::memory_order_release);
+            return *this;
+        }
+
+        // Thread-safe: concurrent first lookups agree on one ArrayFiles.
+        auto get() const -> ArrayFiles&
+        {
+            std::shared_ptr<ArrayFiles> files = m_files.load(std::memory_order_acquire);
+            if (!files)
+            {
+                auto created = std::allocate_shared<ArrayFiles>(std::pmr::polymorphic_allocator<ArrayFiles>{m_directory.get_allocator().resource()}, std::string{m_directory});
+                if (m_files.compare_exchange_strong(files, created, std::memory_order_acq_rel))
+                {
+                    files = std::move(created);
+                }
+            }
+            return *files; // kept alive by m_files
+        }
+    };
+}
+#endif
@@ -0,0 +1,247 @@
+#ifndef FROZEN_INDEX_HPP
+#define FROZEN_INDEX_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <numeric>
+#include <ranges>
+#include <span>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+using str_v = std::string_view;
+
+namespace parameter_parser::reader
+{
+    // Immutable minimal perfect hash over key/value views ("hash and displace"):
+    // keys are hashed into small buckets, and each bucket stores the seed that sends all of its keys
+    // to distinct slots of one flat entry array. A lookup is one hash, two array reads and one key compare.
+    // Prefix queries list the slots in key order.
+    class FrozenIndex
+    {
+    public:
+        struct Entry
+        {
+            str_v key{};
+            str_v value{};
+        };
+
+    private:
+        std::pmr::vector<Entry> m_entries{};
+        std::pmr::vector<int64_t> m_seeds{}; // > 0: displacement seed, < 0: direct slot stored as -(slot + 1)
+        struct KeyOrder
+        {
+            std::once_flag once{};
+            std::pmr::vector<uint32_t> slots{}; // sorted by key
+
+            explicit KeyOrder(std::pmr::memory_resource* resource)
+                : slots{resource}
+            {
+            }
+        };
+        struct KeyOrderDeleter
+        {
+            std::pmr::memory_resource* resource{};
+            auto operator()(KeyOrder* order) const -> void
+            {
+                std::pmr::polymorphic_allocator<KeyOrder>{resource}.delete_object(order);
+            }
+        };
+        // Built by the first prefix query, so lookups-only users never pay for the sort. Null once moved from.
+        std::unique_ptr<KeyOrder, KeyOrderDeleter> m_order; // always set by the constructor
+
+        static auto hash(str_v key) -> uint64_t
+        {
+            return std::hash<str_v>{}(key);
+        }
+        static auto reduce(uint64_t h, size_t range) -> size_t // maps h onto [0, range) without a division
+        {
+#ifdef __SIZEOF_INT128__
+            return static_cast<size_t>((static_cast<unsigned __int128>(h) * range) >> 64);
+#else
+            return static_cast<size_t>(h % range);
+#endif
+        }
+        static auto bucket_of(uint64_t hash, size_t buckets) -> size_t
+        {
+            return reduce(hash, buckets);
+        }
+        static auto slot_of(uint64_t hash, int64_t seed, size_t slots) -> size_t
+        {
+            uint64_t h = hash ^ (static_cast<uint64_t>(seed) * 0x9E3779B97F4A7C15ull); // splitmix64 finalizer
+            h = (h ^ (h >> 30)) * 0xBF58476D1CE4E5B9ull;
+            h = (h ^ (h >> 27)) * 0x94D049BB133111EBull;
+            return reduce(h ^ (h >> 31), slots);
+        }
+
+        // Places every bucket, largest first; returns false if some bucket ran out of seeds.
+        auto try_place(const std::vector<Entry>& entries, const std::vector<uint64_t>& hashes, size_t bucket_count) -> bool
+        {
+            const size_t n = entries.size();
+            std::vector<size_t> bucket_sizes(bucket_count, 0);
+            for (uint64_t h : hashes)
+            {
+                bucket_sizes[bucket_of(h, bucket_count)]++;
+            }
+            std::vector<size_t> bucket_start(bucket_count + 1, 0);
+            std::partial_sum(bucket_sizes.begin(), bucket_sizes.end(), bucket_start.begin() + 1);
+            std::vector<size_t> members(n);
+            std::vector<size_t> fill{bucket_start.begin(), bucket_start.end() - 1};
+            for (size_t i = 0; i < n; i++)
+            {
+                members[fill[bucket_of(hashes[i], bucket_count)]++] = i;
+            }
+            std::vector<size_t> order(bucket_count);
+            std::iota(order.begin(), order.end(), 0);
+            std::ranges::stable_sort(order, std::greater{}, [&](size_t b){return bucket_sizes[b];});
+
+            constexpr int64_t max_seed = 1 << 16;
+            m_seeds.assign(bucket_count, 0);
+            m_entries.assign(n, Entry{});
+            std::vector<bool> taken(n, false);
+            std::vector<size_t> slots{};
+            size_t next_free = 0;
+            for (size_t b : order)
+            {
+                size_t size = bucket_sizes[b];
+                auto bucket = std::span{members}.subspan(bucket_start[b], size);
+                if (size == 0)
+                {
+                    break;
+                }
+                if (size == 1) // singletons go straight into the remaining free slots
+                {
+                    while (taken[next_free])
+                    {
+                        next_free++;
+                    }
+                    taken[next_free]     = true;
+                    m_entries[next_free] = entries[bucket[0]];
+                    m_seeds[b]           = -static_cast<int64_t>(next_free) - 1;
+                    continue;
+                }
+                int64_t seed = 1;
+                for (; seed < max_seed; seed++)
+                {
+                    slots.clear();
+                    bool fits = true;
+                    for (size_t i : bucket)
+                    {
+                        size_t slot = slot_of(hashes[i], seed, n);
+                        if (taken[slot] || std::ranges::find(slots, slot) != slots.end())
+                        {
+                            fits = false;
+                            break;
+                        }
+                        slots.push_back(slot);
+                    }
+                    if (fits)
+                    {
+                        break;
+                    }
+                }
+                if (seed == max_seed)
+                {
+                    return false;
+                }
+                for (size_t k = 0; k < size; k++)
+                {
+                    taken[slots[k]]     = true;
+                    m_entries[slots[k]] = entries[bucket[k]];
+                }
+                m_seeds[b] = seed;
+            }
+            return true;
+        }
+
+    public:
+        FrozenIndex()
+            : FrozenIndex{std::pmr::get_default_resource()}
+        {
+        }
+        explicit FrozenIndex(std::pmr::memory_resource* resource)
+            : m_entries{resource}, m_seeds{resource},
+              m_order{std::pmr::polymorphic_allocator<KeyOrder>{resource}.new_object<KeyOrder>(resource), KeyOrderDeleter{resource}}
+        {
+        }
+
+        // The index tables are allocated from resource; build scratch space comes from the global allocator.
+        template<typename Map>
+        static auto build(const Map& map, std::pmr::memory_resource* resource = std::pmr::get_default_resource()) -> FrozenIndex
+        {
+            std::vector<Entry> entries{};
+            entries.reserve(map.size());
+            for (const auto& [key, value] : map)
+            {
+                entries.push_back(Entry{.key = key, .value = value});
+            }
+            std::vector<uint64_t> hashes(entries.size());
+            std::ranges::transform(entries, hashes.begin(), [](const Entry& e){return hash(e.key);});
+
+            FrozenIndex index{resource};
+            if (entries.empty())
+            {
+                return index;
+            }
+            size_t bucket_count = entries.size() / 4 + 1;
+            while (!index.try_place(entries, hashes, bucket_count))
+            {
+                bucket_count *= 2;
+            }
+            return index;
+        }
+
+        auto find(str_v key) const -> const str_v*
+        {
+            if (m_entries.empty())
+            {
+                return nullptr;
+            }
+            uint64_t h    = hash(key);
+            int64_t seed  = m_seeds[bucket_of(h, m_seeds.size())];
+            size_t slot   = (seed < 0) ? static_cast<size_t>(-(seed + 1)) : slot_of(h, seed, m_entries.size());
+            const auto& e = m_entries[slot];
+            return (e.key == key) ? &e.value : nullptr;
+        }
+        auto size() const -> size_t
+        {
+            return m_entries.size();
+        }
+        auto entries() const -> std::span<const Entry>
+        {
+            return m_entries;
+        }
+        // The entries whose key starts with prefix, in key order: a binary search, then one read per entry.
+        // Thread-safe; the first call sorts the keys.
+        auto with_prefix(str_v prefix) const
+        {
+            static const std::pmr::vector<uint32_t> no_order{};
+            if (m_order)
+            {
+                std::call_once(m_order->once, [this]
+                {
+                    std::vector<std::pair<str_v, uint32_t>> sorted(m_entries.size()); // keys next to their slot: no indirection while sorting
+                    for (uint32_t slot = 0; slot < sorted.size(); slot++)
+                    {
+                        sorted[slot] = {m_entries[slot].key, slot};
+                    }
+                    std::ranges::sort(sorted);
+                    m_order->slots.resize(sorted.size());
+                    std::ranges::transform(sorted, m_order->slots.begin(), &std::pair<str_v, uint32_t>::second);
+                });
+            }
+            const auto& order = m_order ? m_order->slots : no_order; // moved from: there are no entries to list
+            auto key_of = [this](uint32_t slot){return m_entries[slot].key;};
+            auto first  = std::ranges::lower_bound(order, prefix, {}, key_of);
+            auto last   = std::ranges::partition_point(first, order.end(), [&](uint32_t slot){return key_of(slot).starts_with(prefix);});
+            return std::ranges::subrange(first, last) | std::views::transform([this](uint32_t slot) -> const Entry& {return m_entries[slot];});
+        }
+    };
+}
+#endif
@@ -0,0 +1,18 @@
+#ifndef PARAMETER_INSTANTIATIONS_HPP
+#define PARAMETER_INSTANTIATIONS_HPP
+
+// The parsing templates instantiated once by the compiled library (src/parameter_parser.cpp) for the common number types.
+// Targets linking parameter_parser::compiled get PARAMETER_PARSER_COMPILED, and reader.hpp then declares them extern.
+// All of them are inline (constexpr, or member templates defined in the class), and an extern declaration of an inline
+// function is only a hint: compilers may still instantiate it where it is used, eg: to inline it.
+// Expanded after the definitions of ParameterReader and the utilities.
+#define PARAMETER_PARSER_NUM_TYPES(X, prefix) X(prefix, int32_t) X(prefix, int64_t) X(prefix, uint32_t) X(prefix, uint64_t) X(prefix, float) X(prefix, double)
+
+#define PARAMETER_PARSER_INSTANTIATE(prefix, T)                                                                                                       \
+    prefix template auto parameter_parser::utilities::parse_num_handled<T>(str_v) -> std::expected<T, str_v>;                                         \
+    prefix template auto parameter_parser::utilities::join_bad_tokens<T>(str_v, str_v) -> std::string;                                                \
+    prefix template auto parameter_parser::utilities::try_parse_vec<T>(str_v, str_v) -> std::expected<std::vector<T>, std::string>;                   \
+    prefix template auto parameter_parser::reader::ParameterReader::try_parse_num<T>(str_v) const -> std::expected<T, parameter_parser::ReaderError>; \
+    prefix template auto parameter_parser::reader::ParameterReader::try_parse_vector<T>(str_v, str_v) const                                           \
+        -> std::expected<std::vector<T>, parameter_parser::ReaderError>;
+#endif
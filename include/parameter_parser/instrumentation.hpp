@@ -0,0 +1,227 @@
+#ifndef PARAMETER_INSTRUMENTATION_HPP
+#define PARAMETER_INSTRUMENTATION_HPP
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <format>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <numeric>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+using str_v = std::string_view;
+
+namespace parameter_parser::reader
+{
+    // The reader accessors counted by AccessStats.
+    enum class Access
+    {
+        try_parse_num,
+        try_parse_vector,
+        try_get_str,
+        try_parse_matrix,
+        try_parse_sweep,
+        try_bind,
+        try_resolve,
+        try_get_array,
+        try_parse,
+    };
+    inline constexpr size_t access_count = 9;
+
+    inline auto access_as_str(Access access) -> str_v
+    {
+        constexpr std::array<str_v, access_count> names{"try_parse_num", "try_parse_vector", "try_get_str", "try_parse_matrix",
+                                                        "try_parse_sweep", "try_bind", "try_resolve", "try_get_array",
+                                                        "try_parse"};
+        return names[static_cast<size_t>(access)];
+    }
+
+    // Per-key access counters of a ParameterReader built with PARAMETER_PARSER_INSTRUMENTATION defined.
+    // The keys of the file are fixed at build time, so their counters are lock-free atomics; only lookups of
+    // unknown keys (misses) take a mutex. Copies of a reader share its statistics.
+    class AccessStats
+    {
+    public:
+        using Counts = std::array<uint64_t, access_count>;
+
+        struct KeyStats
+        {
+            str_v key{};
+            Counts hits{};
+            uint64_t parse_ns{};
+            uint64_t parsed_bytes{};
+
+            auto total_hits() const -> uint64_t
+            {
+                return std::accumulate(hits.begin(), hits.end(), uint64_t{0});
+            }
+        };
+        struct Miss
+        {
+            std::string key{};
+            Counts misses{};
+        };
+
+    private:
+        struct Counters
+        {
+            std::array<std::atomic<uint64_t>, access_count> hits{};
+            std::atomic<uint64_t> parse_ns{};
+            std::atomic<uint64_t> parsed_bytes{};
+        };
+
+        std::unordered_map<str_v, Counters> m_keys{};
+        mutable std::mutex m_miss_mutex{};
+        std::map<std::string, Counts, std::less<>> m_misses{};
+
+        static auto write_counts(std::ostream& out, const Counts& counts) -> void
+        {
+            for (size_t a = 0; a < access_count; a++)
+            {
+                if (counts[a] > 0)
+                {
+                    out << ' ' << access_as_str(static_cast<Access>(a)) << '=' << counts[a];
+                }
+            }
+        }
+
+    public:
+        // map: the reader's key/value map; its keys must outlive the statistics.
+        template<typename Map>
+        explicit AccessStats(const Map& map)
+        {
+            m_keys.reserve(map.size());
+            for (const auto& [key, value] : map)
+            {
+                m_keys.try_emplace(key);
+            }
+        }
+
+        auto record_lookup(str_v key, Access access, bool hit) -> void
+        {
+            if (auto it = m_keys.find(key); hit && it != m_keys.end())
+            {
+                it->second.hits[static_cast<size_t>(access)].fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            std::lock_guard lock{m_miss_mutex};
+            auto it = m_misses.find(key);
+            if (it == m_misses.end())
+            {
+                it = m_misses.emplace(std::string{key}, Counts{}).first;
+            }
+            it->second[static_cast<size_t>(access)]++;
+        }
+        auto record_parse(str_v key, std::chrono::nanoseconds elapsed, size_t bytes) -> void
+        {
+            if (auto it = m_keys.find(key); it != m_keys.end())
+            {
+                it->second.parse_ns.fetch_add(static_cast<uint64_t>(elapsed.count()), std::memory_order_relaxed);
+                it->second.parsed_bytes.fetch_add(bytes, std::memory_order_relaxed);
+            }
+        }
+
+        // Every key of the file, sorted.
+        auto keys() const -> std::vector<KeyStats>
+        {
+            std::vector<KeyStats> stats{};
+            stats.reserve(m_keys.size());
+            for (const auto& [key, counters] : m_keys)
+            {
+                KeyStats entry{.key = key, .parse_ns = counters.parse_ns.load(), .parsed_bytes = counters.parsed_bytes.load()};
+                std::ranges::transform(counters.hits, entry.hits.begin(), [](const auto& count){return count.load();});
+                stats.push_back(entry);
+            }
+            std::ranges::sort(stats, {}, &KeyStats::key);
+            return stats;
+        }
+        // Keys of the file that no accessor has read: dead or misspelled parameters.
+        auto never_accessed() const -> std::vector<str_v>
+        {
+            std::vector<str_v> unused{};
+            for (const auto& stats : keys())
+            {
+                if (stats.total_hits() == 0)
+                {
+                    unused.push_back(stats.key);
+                }
+            }
+            return unused;
+        }
+        // Keys that were asked for but are not in the file, sorted.
+        auto misses() const -> std::vector<Miss>
+        {
+            std::lock_guard lock{m_miss_mutex};
+            std::vector<Miss> missed{};
+            for (const auto& [key, counts] : m_misses)
+            {
+                missed.push_back(Miss{.key = key, .misses = counts});
+            }
+            return missed;
+        }
+
+        auto write_report(std::ostream& out) const -> void
+        {
+            auto stats  = keys();
+            auto unused = never_accessed();
+            auto missed = misses();
+            out << std::format("Parameter access report: {} keys, {} never accessed, {} missing keys looked up\n", stats.size(), unused.size(), missed.size());
+            for (const auto& entry : stats)
+            {
+                if (entry.total_hits() == 0)
+                {
+                    continue;
+                }
+                out << "  " << entry.key << ':';
+                write_counts(out, entry.hits);
+                if (entry.parsed_bytes > 0)
+                {
+                    out << std::format(", parsed {} bytes in {:.3f} us", entry.parsed_bytes, static_cast<double>(entry.parse_ns) / 1e3);
+                }
+                out << '\n';
+            }
+            out << "Never accessed:\n";
+            for (str_v key : unused)
+            {
+                out << "  " << key << '\n';
+            }
+            out << "Missing keys:\n";
+            for (const auto& miss : missed)
+            {
+                out << "  " << miss.key << ':';
+                write_counts(out, miss.misses);
+                out << '\n';
+            }
+        }
+    };
+
+    // Adds the time between its construction and destruction to the parse time of key.
+    class ParseTimer
+    {
+        AccessStats* m_stats{};
+        str_v m_key{};
+        size_t m_bytes{};
+        std::chrono::steady_clock::time_point m_start{};
+
+    public:
+        ParseTimer(AccessStats& stats, str_v key, str_v value)
+            : m_stats{&stats}, m_key{key}, m_bytes{value.size()}, m_start{std::chrono::steady_clock::now()}
+        {
+        }
+        ParseTimer(const ParseTimer&) = delete;
+        ParseTimer& operator=(const ParseTimer&) = delete;
+        ~ParseTimer()
+        {
+            m_stats->record_parse(m_key, std::chrono::steady_clock::now() - m_start, m_bytes);
+        }
+    };
+}
+#endif
@@ -0,0 +1,231 @@
+#ifndef LAYERED_READER_HPP
+#define LAYERED_READER_HPP
+
+#include <array>
+#include <expected>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "parameter_parser/reader.hpp"
+#include "parameter_parser/reader_error.hpp"
+
+namespace parameter_parser::reader
+{
+    // An ordered stack of readers, eg: base file, site file, run file, command-line overrides.
+    // A key resolves to the topmost layer that holds it; the layers are shared, never copied, so one large base
+    // reader can sit under any number of overlays. Parsing and errors are those of the layer that provides the key.
+    class LayeredReader
+    {
+        std::vector<std::shared_ptr<const ParameterReader>> m_layers{}; // bottom first
+
+        // Visits each effective entry once, top layer first, skipping entries shadowed by a higher layer.
+        template<typename F>
+        auto for_each_entry(F&& visitor) const -> void
+        {
+            for (size_t top = m_layers.size(); top-- > 0;)
+            {
+                m_layers[top]->for_each_entry([&](str_v key, str_v value)
+                {
+                    for (size_t above = top + 1; above < m_layers.size(); above++)
+                    {
+                        if (m_layers[above]->find(key) != nullptr)
+                        {
+                            return;
+                        }
+                    }
+                    visitor(*m_layers[top], key, value);
+                });
+            }
+        }
+        // The layer that provides key and its value, found with one probe per layer from the top; the top layer and
+        // nullptr when no layer holds key. The layer's accessors then parse that value without looking key up again.
+        auto locate(str_v key, [[maybe_unused]] Access access) const -> std::pair<const ParameterReader*, const str_v*>
+        {
+            std::pair<const ParameterReader*, const str_v*> found{m_layers.back().get(), nullptr};
+            for (auto layer = m_layers.rbegin(); layer != m_layers.rend() && found.second == nullptr; ++layer)
+            {
+                if (const str_v* value = (*layer)->find(key); value != nullptr)
+                {
+                    found = {layer->get(), value};
+                }
+            }
+#ifdef PARAMETER_PARSER_INSTRUMENTATION
+            found.first->m_stats->record_lookup(key, access, found.second != nullptr);
+#endif
+            return found;
+        }
+
+    public:
+        explicit LayeredReader(std::shared_ptr<const ParameterReader> base)
+            : m_layers{std::move(base)}
+        {
+        }
+
+        // Adds a layer on top of the others.
+        auto push(std::shared_ptr<const ParameterReader> layer) -> LayeredReader&
+        {
+            m_layers.push_back(std::move(layer));
+            return *this;
+        }
+        auto push(ParameterReader&& layer) -> LayeredReader&
+        {
+            return push(std::make_shared<const ParameterReader>(std::move(layer)));
+        }
+        // Adds a layer built from key/value overrides such as the "key=value" arguments of a command line.
+        auto push_overrides(std::span<const str_v> overrides, str_v delimiter = "=", Mode mode = Mode::Strict) -> std::expected<void, ReaderError>
+        {
+            std::string text{};
+            for (str_v entry : overrides)
+            {
+                text.append(entry).push_back('\n');
+            }
+            return ParameterReader::build_from_source(SourceBuffer::copy_of(text), delimiter, mode).transform([&](ParameterReader&& layer)
+            {
+                push(std::move(layer));
+            });
+        }
+        auto layer_count() const -> size_t
+        {
+            return m_layers.size();
+        }
+        // The layer that provides key, or the top layer when none does: for ParameterReader accessors not forwarded here.
+        auto reader_for(str_v key) const -> const ParameterReader&
+        {
+            for (auto layer = m_layers.rbegin(); layer != m_layers.rend(); ++layer)
+            {
+                if ((*layer)->find(key) != nullptr)
+                {
+                    return **layer;
+                }
+            }
+            return *m_layers.back();
+        }
+
+        // Collapses the stack into one frozen reader holding the effective entries. Its values still point into the
+        // layers' sources, which it keeps alive, so flattening copies no text. Its relative "@path" values resolve against
+        // the working directory rather than the directory of their layer.
+        auto flatten() const -> ParameterReader
+        {
+            struct Owner
+            {
+                std::vector<std::shared_ptr<const ParameterReader>> layers{};
+                SourceBuffer empty{};
+            };
+            auto owner = std::make_shared<const Owner>(Owner{.layers = m_layers});
+            ParameterMap map{};
+            for_each_entry([&](const ParameterReader&, str_v key, str_v value){map.emplace(key, value);});
+
+            ParameterReader flat{std::shared_ptr<const SourceBuffer>{owner, &owner->empty}, std::move(map)};
+            flat.m_source_is_text = false; // its values are slices of several sources
+            flat.freeze();
+            return flat;
+        }
+
+        template<typename T>
+        auto try_parse_num(str_v key) const -> std::expected<T, ReaderError>
+            requires std::is_integral_v<T> || std::is_floating_point_v<T>
+        {
+            auto [layer, value] = locate(key, Access::try_parse_num);
+            return layer->template parse_num_as<T>(key, value);
+        }
+        template<typename T>
+        auto parse_num_or_exit(str_v key) const -> T
+            requires std::is_integral_v<T> || std::is_floating_point_v<T>
+        {
+            return try_parse_num<T>(key).transform_error(exit_if_err).value();
+        }
+        template<typename T>
+        auto try_parse_vector(str_v key, str_v delim) const -> std::expected<std::vector<T>, ReaderError>
+            requires utilities::Parsable<T>
+        {
+            auto [layer, value] = locate(key, Access::try_parse_vector);
+            return layer->parse_vector_as(key, value, delim, std::vector<T>{});
+        }
+        template<typename T>
+        auto parse_vector_or_exit(str_v key, str_v delim) const -> std::vector<T>
+            requires utilities::Parsable<T>
+        {
+            return try_parse_vector<T>(key, delim).transform_error(exit_if_err).value();
+        }
+        template<typename T>
+        auto try_parse_sweep(str_v key) const -> std::expected<Sweep<T>, ReaderError>
+            requires std::is_integral_v<T> || std::is_floating_point_v<T>
+        {
+            auto [layer, value] = locate(key, Access::try_parse_sweep);
+            return layer->template parse_sweep_as<T>(key, value);
+        }
+        template<typename T>
+        auto try_parse_matrix(str_v key, str_v row_delim, str_v col_delim) const -> std::expected<Matrix<T>, ReaderError>
+            requires std::is_integral_v<T> || std::is_floating_point_v<T>
+        {
+            auto [layer, value] = locate(key, Access::try_parse_matrix);
+            return layer->template parse_matrix_as<Matrix<T>>(key, value, [&](str_v text){return utilities::try_parse_matrix<T>(text, row_delim, col_delim);});
+        }
+        auto try_get_str(str_v key) const -> std::expected<std::string, ReaderError>
+        {
+            return ParameterReader::copy_str(key, locate(key, Access::try_get_str).second);
+        }
+        auto get_str_or_exit(str_v key) const -> std::string
+        {
+            return try_get_str(key).transform_error(exit_if_err).value();
+        }
+        template<typename T>
+        auto try_get_array(str_v key) const -> std::expected<std::span<const T>, ReaderError>
+            requires std::is_integral_v<T> || std::is_floating_point_v<T>
+        {
+            auto [layer, value] = locate(key, Access::try_get_array);
+            return layer->template map_array<T>(key, value).transform([](const auto& array){return array.first;});
+        }
+        template<utilities::Parsable T>
+        auto try_parse(str_v key) const -> std::expected<T, ReaderError>
+        {
+            auto [layer, value] = locate(key, Access::try_parse);
+            return layer->template parse_value_as<T>(key, value);
+        }
+        template<utilities::Parsable T, size_t N>
+        auto try_parse_array(str_v key, str_v delim) const -> std::expected<std::array<T, N>, ReaderError>
+        {
+            auto [layer, value] = locate(key, Access::try_parse_vector);
+            return layer->template parse_array_as<T, N>(key, value, delim);
+        }
+
+        template<typename SchemaT>
+        auto try_bind() const -> std::expected<typename SchemaT::value_type, std::vector<ReaderError>>
+        {
+            return SchemaT::bind([this](auto&& visitor)
+            {
+                for_each_entry([&]([[maybe_unused]] const ParameterReader& layer, str_v key, str_v value)
+                {
+#ifdef PARAMETER_PARSER_INSTRUMENTATION
+                    if (SchemaT::contains(key))
+                    {
+                        layer.m_stats->record_lookup(key, Access::try_bind, true);
+                    }
+#endif
+                    visitor(key, value);
+                });
+            });
+        }
+        template<typename SchemaT>
+        auto bind_or_exit() const -> typename SchemaT::value_type
+        {
+            return try_bind<SchemaT>().transform_error(exit_if_errs).value();
+        }
+        template<typename... Ts>
+        auto try_resolve(const Request<Ts>&... requests) const -> std::expected<std::tuple<Ts...>, std::vector<ReaderError>>
+        {
+            return resolve([this](str_v key){return locate(key, Access::try_resolve).second;}, requests...);
+        }
+        template<typename... Ts>
+        auto resolve_or_exit(const Request<Ts>&... requests) const -> std::tuple<Ts...>
+        {
+            return try_resolve(requests...).transform_error(exit_if_errs).value();
+        }
+    };
+}
+#endif
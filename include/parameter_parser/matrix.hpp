@@ -0,0 +1,176 @@
+#ifndef PARAMETER_MATRIX_HPP
+#define PARAMETER_MATRIX_HPP
+
+#include <cstddef>
+#include <expected>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#if __has_include(<mdspan>)
+#include <mdspan>
+#endif
+
+#include "parameter_parser/utilities.hpp"
+
+namespace parameter_parser::utilities
+{
+    struct MatrixShape
+    {
+        size_t rows{};
+        size_t cols{};
+
+        auto size() const -> size_t
+        {
+            return rows * cols;
+        }
+        friend auto operator==(const MatrixShape&, const MatrixShape&) -> bool = default;
+    };
+
+#ifdef __cpp_lib_mdspan
+    template<typename T>
+    using MatrixSpan = std::mdspan<T, std::dextents<size_t, 2>>;
+
+    // Row-major view over caller-owned storage, eg: the buffer filled by try_parse_matrix_into.
+    template<typename T>
+    auto as_mdspan(std::span<T> values, MatrixShape shape) -> MatrixSpan<T>
+    {
+        return MatrixSpan<T>{values.data(), shape.rows, shape.cols};
+    }
+#endif
+
+    // Row-major values in one contiguous buffer, with their shape.
+    template<typename T>
+    class Matrix
+    {
+        std::vector<T> m_values{};
+        MatrixShape m_shape{};
+
+    public:
+        Matrix() = default;
+        Matrix(std::vector<T> values, MatrixShape shape)
+            : m_values{std::move(values)}, m_shape{shape}
+        {
+        }
+
+        auto shape() const -> MatrixShape
+        {
+            return m_shape;
+        }
+        auto rows() const -> size_t
+        {
+            return m_shape.rows;
+        }
+        auto cols() const -> size_t
+        {
+            return m_shape.cols;
+        }
+        auto values() const -> std::span<const T>
+        {
+            return m_values;
+        }
+        auto operator[](size_t row, size_t col) const -> const T&
+        {
+            return m_values[row * m_shape.cols + col];
+        }
+        auto row(size_t row) const -> std::span<const T>
+        {
+            return values().subspan(row * m_shape.cols, m_shape.cols);
+        }
+#ifdef __cpp_lib_mdspan
+        auto view() const -> MatrixSpan<const T>
+        {
+            return MatrixSpan<const T>{m_values.data(), m_shape.rows, m_shape.cols};
+        }
+#endif
+    };
+
+    // Parses rows split on row_delim, each holding the same number of values split on col_delim (eg: "1, 0; 0, 1"),
+    // in a single scan, handing each number to push(T), which returns false once there is no room left.
+    // The first error is returned: a malformed number, a value that does not fit, or a ragged row (the whole row).
+    // An empty line is a 0 x 0 matrix.
+    template<typename T, typename Push>
+    auto parse_matrix(str_v line, str_v row_delim, str_v col_delim, Push&& push) -> expected<MatrixShape, TokenError>
+        requires std::is_integral_v<T> || std::is_floating_point_v<T>
+    {
+        MatrixShape shape{};
+        std::optional<TokenError> error{};
+        for_each_token(line, row_delim, [&](str_v row, size_t row_offset)
+        {
+            size_t cols = 0;
+            for_each_token(row, col_delim, [&](str_v token, size_t offset)
+            {
+                cols++;
+                if (error.has_value())
+                {
+                    return;
+                }
+                auto result = parse_num_handled<T>(token);
+                if (!result || !push(result.value()))
+                {
+                    error = TokenError{.token = token, .offset = row_offset + offset};
+                }
+            });
+            if (!error.has_value() && shape.rows > 0 && cols != shape.cols)
+            {
+                error = TokenError{.token = row, .offset = row_offset};
+            }
+            shape.cols = (shape.rows == 0) ? cols : shape.cols;
+            shape.rows++;
+        });
+        if (error.has_value())
+        {
+            return std::unexpected(error.value());
+        }
+        return shape;
+    }
+
+    // Appends the values to out in a single pass over line (no pre-count of rows and columns). On error out is left unchanged.
+    template<typename T, typename Alloc>
+    auto try_parse_matrix_into(str_v line, str_v row_delim, str_v col_delim, std::vector<T, Alloc>& out) -> expected<MatrixShape, TokenError>
+        requires std::is_integral_v<T> || std::is_floating_point_v<T>
+    {
+        const size_t old_size = out.size();
+        auto shape = parse_matrix<T>(line, row_delim, col_delim, [&](T value)
+        {
+            out.push_back(value);
+            return true;
+        });
+        if (!shape)
+        {
+            out.resize(old_size);
+        }
+        return shape;
+    }
+
+    // Parses into caller-owned storage, without allocating. A matrix larger than out is an error.
+    template<typename T>
+    auto try_parse_matrix_into(str_v line, str_v row_delim, str_v col_delim, std::span<T> out) -> expected<MatrixShape, TokenError>
+        requires std::is_integral_v<T> || std::is_floating_point_v<T>
+    {
+        size_t written = 0;
+        return parse_matrix<T>(line, row_delim, col_delim, [&](T value)
+        {
+            if (written == out.size())
+            {
+                return false;
+            }
+            out[written++] = value;
+            return true;
+        });
+    }
+
+    template<typename T>
+    auto try_parse_matrix(str_v line, str_v row_delim, str_v col_delim) -> expected<Matrix<T>, TokenError>
+        requires std::is_integral_v<T> || std::is_floating_point_v<T>
+    {
+        std::vector<T> values{};
+        return try_parse_matrix_into<T>(line, row_delim, col_delim, values).transform([&](MatrixShape shape)
+        {
+            return Matrix<T>{std::move(values), shape};
+        });
+    }
+}
+#endif
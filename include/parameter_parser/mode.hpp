@@ -0,0 +1,13 @@
+#ifndef PARAMETER_MODE_HPP
+#define PARAMETER_MODE_HPP
+
+namespace parameter_parser::reader
+{
+    // How lines without a delimiter are treated: Strict rejects them, Permissive skips them.
+    enum class Mode
+    {
+        Permissive,
+        Strict,
+    };
+}
+#endif
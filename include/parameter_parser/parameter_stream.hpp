@@ -0,0 +1,210 @@
+#ifndef PARAMETER_STREAM_HPP
+#define PARAMETER_STREAM_HPP
+
+#include <algorithm>
+#include <expected>
+#include <fstream>
+#include <istream>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "parameter_parser/mode.hpp"
+#include "parameter_parser/reader_error.hpp"
+#include "parameter_parser/utilities.hpp"
+
+namespace parameter_parser::reader
+{
+    struct KeyValue
+    {
+        str_v key{};
+        str_v value{};
+    };
+
+    // Single-pass input range over the (key, value) records of a parameter file, without building a map.
+    // The input is read in chunk_size blocks; only lines longer than a chunk grow the buffer.
+    // Records are views into that buffer: they stay valid until the iterator is incremented.
+    // As with ParameterReader::build, keys following a "[section]" line are yielded as "section.key"; "[]" ends the section.
+    // In Mode::Strict a line without delimiter yields one ReaderError and ends the iteration,
+    // in Mode::Permissive it is skipped.
+    class ParameterStream
+    {
+    public:
+        using value_type = std::expected<KeyValue, ReaderError>;
+        static constexpr size_t default_chunk_size = 64 * 1024;
+
+    private:
+        std::unique_ptr<std::ifstream> m_owned_input{};
+        std::istream* m_input{};
+        std::string m_delimiter{};
+        Mode m_mode{};
+        std::vector<char> m_buffer{};
+        size_t m_begin{};
+        size_t m_end{};
+        bool m_input_done{};
+        bool m_done{};
+        std::string m_section{};
+        std::vector<char> m_qualified_key{}; // "section.key" of the current record (a vector: its data survives a move)
+        std::optional<value_type> m_current{};
+
+        ParameterStream(std::istream& input, str_v delimiter, Mode mode, size_t chunk_size)
+            : m_input{&input}, m_delimiter{delimiter}, m_mode{mode}, m_buffer(std::max<size_t>(chunk_size, 1))
+        {
+        }
+
+        auto fill() -> void
+        {
+            if (m_begin > 0) // keep the unfinished line at the front of the buffer
+            {
+                std::copy(m_buffer.begin() + m_begin, m_buffer.begin() + m_end, m_buffer.begin());
+                m_end  -= m_begin;
+                m_begin = 0;
+            }
+            if (m_end == m_buffer.size()) // a single line is longer than the buffer
+            {
+                m_buffer.resize(2 * m_buffer.size());
+            }
+            m_input->read(m_buffer.data() + m_end, static_cast<std::streamsize>(m_buffer.size() - m_end));
+            m_end += static_cast<size_t>(m_input->gcount());
+            m_input_done = !(*m_input);
+        }
+        auto next_line() -> std::optional<str_v>
+        {
+            while (true)
+            {
+                str_v pending{m_buffer.data() + m_begin, m_end - m_begin};
+                if (size_t n = pending.find('\n'); n != str_v::npos)
+                {
+                    m_begin += n + 1;
+                    return pending.substr(0, n);
+                }
+                if (m_input_done)
+                {
+                    m_begin = m_end;
+                    return pending.empty() ? std::nullopt : std::optional{pending};
+                }
+                fill();
+            }
+        }
+        auto qualified(str_v key) -> str_v
+        {
+            if (m_section.empty())
+            {
+                return key;
+            }
+            m_qualified_key.assign(m_section.begin(), m_section.end());
+            m_qualified_key.push_back('.');
+            m_qualified_key.insert(m_qualified_key.end(), key.begin(), key.end());
+            return str_v{m_qualified_key.data(), m_qualified_key.size()};
+        }
+        auto advance() -> void
+        {
+            m_current.reset();
+            while (!m_done)
+            {
+                auto line = next_line();
+                if (!line.has_value())
+                {
+                    m_done = true;
+                    return;
+                }
+                if (auto header = utilities::section_header(line.value(), m_delimiter); header.has_value())
+                {
+                    m_section.assign(header.value());
+                    continue;
+                }
+                auto key_val = utilities::split_once(line.value(), m_delimiter);
+                if (key_val.has_value())
+                {
+                    auto[key, value] = key_val.value();
+                    m_current = KeyValue{.key = qualified(utilities::trim(key)), .value = utilities::trim(value)};
+                    return;
+                }
+                if (m_mode == Mode::Strict)
+                {
+                    ReaderError error{.args = std::string{line.value()}, .from = ReaderError::From::build, .kind = ReaderError::Kind::ParseError};
+                    m_current = std::unexpected(error);
+                    m_done    = true;
+                    return;
+                }
+            }
+        }
+
+    public:
+        ParameterStream(ParameterStream&&) = default;
+        ParameterStream& operator=(ParameterStream&&) = default;
+
+        // Streams from a caller-owned input (eg: std::cin), which must outlive the stream.
+        static auto from_istream(std::istream& input, str_v delimiter, Mode mode = Mode::Strict, size_t chunk_size = default_chunk_size) -> ParameterStream
+        {
+            return ParameterStream{input, delimiter, mode, chunk_size};
+        }
+        static auto open(const std::string& file_path, str_v delimiter, Mode mode = Mode::Strict, size_t chunk_size = default_chunk_size) -> std::expected<ParameterStream, ReaderError>
+        {
+            auto file = std::make_unique<std::ifstream>(file_path, std::ios::binary);
+            if (!file->is_open())
+            {
+                ReaderError error{.args = file_path, .from = ReaderError::From::build, .kind = ReaderError::Kind::FileError};
+                return std::unexpected(error);
+            }
+            ParameterStream stream{*file, delimiter, mode, chunk_size};
+            stream.m_owned_input = std::move(file);
+            return stream;
+        }
+
+        class iterator
+        {
+            ParameterStream* m_stream{};
+
+        public:
+            using iterator_concept = std::input_iterator_tag;
+            using value_type       = ParameterStream::value_type;
+            using difference_type  = std::ptrdiff_t;
+
+            iterator() = default;
+            explicit iterator(ParameterStream& stream)
+                : m_stream{&stream}
+            {
+            }
+            auto operator*() const -> const value_type&
+            {
+                return m_stream->m_current.value();
+            }
+            auto operator++() -> iterator&
+            {
+                m_stream->advance();
+                return *this;
+            }
+            auto operator++(int) -> void
+            {
+                ++*this;
+            }
+            auto at_end() const -> bool
+            {
+                return !m_stream->m_current.has_value();
+            }
+            friend auto operator==(const iterator& it, std::default_sentinel_t) -> bool
+            {
+                return it.at_end();
+            }
+        };
+
+        // Can only be iterated once.
+        auto begin() -> iterator
+        {
+            if (!m_current.has_value())
+            {
+                advance();
+            }
+            return iterator{*this};
+        }
+        auto end() -> std::default_sentinel_t
+        {
+            return std::default_sentinel;
+        }
+    };
+}
+#endif
@@ -0,0 +1,144 @@
+#ifndef PARSE_CACHE_HPP
+#define PARSE_CACHE_HPP
+
+#include <any>
+#include <expected>
+#include <functional>
+#include <mutex>
+#include <shared_mutex>
+#include <span>
+#include <string>
+#include <string_view>
+#include <typeindex>
+#include <unordered_map>
+#include <vector>
+
+#include "parameter_parser/reader.hpp"
+#include "parameter_parser/reader_error.hpp"
+
+namespace parameter_parser::reader
+{
+    // Opt-in memoization of parsed values, keyed on (key, requested type, delimiter): each value is parsed once,
+    // later calls return a copy of the number or a span into the cached vector.
+    //  - Thread safety: all member functions may be called concurrently. Cached hits only take a shared lock;
+    //    on a miss the value is parsed outside the lock and the first inserted result is kept.
+    //  - Invalidation: cached values never change, so returned spans stay valid until clear() or the cache is destroyed.
+    //    clear() must not run while another thread still uses such a span. Errors are not cached.
+    //  - The reader is borrowed and must outlive the cache.
+    class ParseCache
+    {
+        struct KeyView
+        {
+            str_v key{};
+            std::type_index type;
+            str_v delim{};
+        };
+        struct Key
+        {
+            std::string key{};
+            std::type_index type;
+            std::string delim{};
+
+            auto view() const -> KeyView
+            {
+                return KeyView{.key = key, .type = type, .delim = delim};
+            }
+        };
+        struct KeyHash
+        {
+            using is_transparent = void;
+            auto operator()(const KeyView& k) const -> size_t
+            {
+                size_t h = std::hash<str_v>{}(k.key);
+                h ^= k.type.hash_code() + 0x9E3779B97F4A7C15ull + (h << 6) + (h >> 2);
+                h ^= std::hash<str_v>{}(k.delim) + 0x9E3779B97F4A7C15ull + (h << 6) + (h >> 2);
+                return h;
+            }
+            auto operator()(const Key& k) const -> size_t
+            {
+                return (*this)(k.view());
+            }
+        };
+        struct KeyEqual
+        {
+            using is_transparent = void;
+            static auto equal(const KeyView& a, const KeyView& b) -> bool
+            {
+                return a.key == b.key && a.type == b.type && a.delim == b.delim;
+            }
+            auto operator()(const auto& a, const auto& b) const -> bool
+            {
+                return equal(as_view(a), as_view(b));
+            }
+            static auto as_view(const Key& k) -> KeyView
+            {
+                return k.view();
+            }
+            static auto as_view(const KeyView& k) -> KeyView
+            {
+                return k;
+            }
+        };
+
+        const ParameterReader* m_reader{};
+        mutable std::shared_mutex m_mutex{};
+        mutable std::unordered_map<Key, std::any, KeyHash, KeyEqual> m_values{};
+
+        template<typename V, typename Parse>
+        auto get_or_parse(KeyView cache_key, Parse&& parse) const -> std::expected<const V*, ReaderError>
+        {
+            {
+                std::shared_lock lock{m_mutex};
+                if (auto it = m_values.find(cache_key); it != m_values.end())
+                {
+                    return std::any_cast<V>(&it->second);
+                }
+            }
+            std::expected<V, ReaderError> parsed = parse();
+            if (!parsed)
+            {
+                return std::unexpected(std::move(parsed.error()));
+            }
+            std::unique_lock lock{m_mutex};
+            Key key{.key = std::string{cache_key.key}, .type = cache_key.type, .delim = std::string{cache_key.delim}};
+            auto [it, inserted] = m_values.try_emplace(std::move(key), std::move(parsed.value()));
+            return std::any_cast<V>(&it->second);
+        }
+
+    public:
+        explicit ParseCache(const ParameterReader& reader)
+            : m_reader{&reader}
+        {
+        }
+
+        template<typename T>
+        auto try_parse_num(str_v key) const -> std::expected<T, ReaderError>
+            requires std::is_integral_v<T> || std::is_floating_point_v<T>
+        {
+            KeyView cache_key{.key = key, .type = typeid(T), .delim = {}};
+            return get_or_parse<T>(cache_key, [&]{return m_reader->try_parse_num<T>(key);}).transform([](const T* value){return *value;});
+        }
+        template<typename T>
+        auto try_parse_vector(str_v key, str_v delim) const -> std::expected<std::span<const T>, ReaderError>
+            requires std::is_integral_v<T> || std::is_floating_point_v<T>
+        {
+            KeyView cache_key{.key = key, .type = typeid(std::vector<T>), .delim = delim};
+            return get_or_parse<std::vector<T>>(cache_key, [&]{return m_reader->try_parse_vector<T>(key, delim);}).transform([](const std::vector<T>* values)
+            {
+                return std::span<const T>{*values};
+            });
+        }
+        auto size() const -> size_t
+        {
+            std::shared_lock lock{m_mutex};
+            return m_values.size();
+        }
+        // Drops every cached value, invalidating the spans handed out so far.
+        auto clear() -> void
+        {
+            std::unique_lock lock{m_mutex};
+            m_values.clear();
+        }
+    };
+}
+#endif
@@ -0,0 +1,295 @@
+#ifndef PARAMETER_PARSE_TRAITS_HPP
+#define PARAMETER_PARSE_TRAITS_HPP
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <complex>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <limits>
+#include <numeric>
+#include <optional>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#include "parameter_parser/utilities.hpp"
+
+namespace parameter_parser::utilities
+{
+    // Customization point of the typed reader accessors (ParameterReader::try_parse, try_parse_array, try_parse_vector...):
+    //     template<> struct parameter_parser::utilities::ParseTraits<Color>
+    //     {
+    //         static auto parse(str_v value) -> std::expected<Color, str_v>; // on failure, the malformed part of value
+    //     };
+    // value is a view into the parameter file: parsing copies nothing unless T itself owns memory.
+    template<typename T>
+    struct ParseTraits;
+
+    template<typename T>
+    concept Parsable = requires(str_v value)
+    {
+        { ParseTraits<T>::parse(value) } -> std::same_as<std::expected<T, str_v>>;
+    };
+
+    template<Parsable T>
+    constexpr auto parse_value(str_v value) -> std::expected<T, str_v>
+    {
+        return ParseTraits<T>::parse(value);
+    }
+
+    // The types parsed by parse_num_handled, which also read sweeps as vectors.
+    template<typename T>
+    concept Number = (std::is_integral_v<T> && !std::is_same_v<T, bool>) || std::is_floating_point_v<T>;
+
+    template<Number T>
+    struct ParseTraits<T>
+    {
+        static constexpr auto parse(str_v value) -> std::expected<T, str_v>
+        {
+            return parse_num_handled<T>(value);
+        }
+    };
+
+    // Lower-case ASCII comparison, for the keywords below.
+    constexpr auto equals_ignoring_case(str_v text, str_v lower) -> bool
+    {
+        return std::ranges::equal(text, lower, {}, [](char c){return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;});
+    }
+
+    // true/false, yes/no, on/off or 1/0, in any case.
+    template<>
+    struct ParseTraits<bool>
+    {
+        static constexpr auto parse(str_v value) -> std::expected<bool, str_v>
+        {
+            for (str_v word : {"true"sv, "yes"sv, "on"sv, "1"sv})
+            {
+                if (equals_ignoring_case(value, word))
+                {
+                    return true;
+                }
+            }
+            for (str_v word : {"false"sv, "no"sv, "off"sv, "0"sv})
+            {
+                if (equals_ignoring_case(value, word))
+                {
+                    return false;
+                }
+            }
+            return std::unexpected(value);
+        }
+    };
+
+    // The spelling of each value of an enum, which makes it Parsable, eg:
+    //     template<> struct parameter_parser::utilities::EnumNames<Color>
+    //     {
+    //         static constexpr std::array<std::pair<str_v, Color>, 2> names{{{"red", Color::red}, {"green", Color::green}}};
+    //     };
+    template<typename E>
+    struct EnumNames;
+
+    template<typename E>
+    concept NamedEnum = std::is_enum_v<E> && requires
+    {
+        { EnumNames<E>::names.begin()->first } -> std::convertible_to<str_v>;
+        { EnumNames<E>::names.begin()->second } -> std::convertible_to<E>;
+    };
+
+    template<NamedEnum E>
+    struct ParseTraits<E>
+    {
+        static constexpr auto parse(str_v value) -> std::expected<E, str_v>
+        {
+            for (const auto& [name, enumerator] : EnumNames<E>::names)
+            {
+                if (name == value)
+                {
+                    return enumerator;
+                }
+            }
+            return std::unexpected(value);
+        }
+    };
+
+    // A number followed by a unit: ns, us, ms, s, min, h or d, eg: "250ms", "1.5 h". A bare number counts the duration's
+    // own period. A value that is not finite, not a whole number of periods of an integral Rep, or that Rep cannot hold,
+    // is malformed. Integer counts of an integral Rep are scaled exactly rather than through a double.
+    template<typename Rep, typename Period>
+    struct ParseTraits<std::chrono::duration<Rep, Period>>
+    {
+        static auto parse(str_v value) -> std::expected<std::chrono::duration<Rep, Period>, str_v>
+        {
+            struct Unit
+            {
+                str_v name{};
+                int64_t num{};
+                int64_t den{};
+            };
+            constexpr std::array<Unit, 7> units{{{"ns", 1, 1'000'000'000}, {"us", 1, 1'000'000}, {"ms", 1, 1'000}, {"s", 1, 1},
+                                                 {"min", 60, 1}, {"h", 3'600, 1}, {"d", 86'400, 1}}};
+            double count{};
+            auto [end, ec] = std::from_chars(value.data(), value.data() + value.length(), count);
+            if (ec != std::errc{} || !std::isfinite(count)) // from_chars accepts "nan" and "inf"
+            {
+                return std::unexpected(value);
+            }
+            str_v suffix = trim(value.substr(static_cast<size_t>(end - value.data())));
+            Unit unit{.name = {}, .num = Period::num, .den = Period::den};
+            if (!suffix.empty())
+            {
+                auto known = std::ranges::find(units, suffix, &Unit::name);
+                if (known == units.end())
+                {
+                    return std::unexpected(suffix);
+                }
+                unit = *known;
+            }
+            // count * (unit.num / unit.den) / (Period::num / Period::den), reduced so exact ratios stay exact
+            int64_t num = unit.num * Period::den;
+            int64_t den = unit.den * Period::num;
+            int64_t gcd = std::gcd(num, den);
+            num /= gcd;
+            den /= gcd;
+            if constexpr (std::is_integral_v<Rep>)
+            {
+                Rep whole{};
+                auto [whole_end, whole_ec] = std::from_chars(value.data(), end, whole);
+                if (whole_ec == std::errc{} && whole_end == end)
+                {
+                    if (auto ticks = scale_exactly(whole, num, den))
+                    {
+                        return std::chrono::duration<Rep, Period>{ticks.value()};
+                    }
+                    return std::unexpected(value);
+                }
+            }
+            count = count * static_cast<double>(num) / static_cast<double>(den);
+            if (!std::isfinite(count))
+            {
+                return std::unexpected(value);
+            }
+            if constexpr (std::is_integral_v<Rep>)
+            {
+                // 2^digits is the first count past max(), and unlike max() it converts to double exactly
+                double whole = std::round(count);
+                if (std::abs(count - whole) > 1e-9 * std::max(1.0, std::abs(whole)) || whole < static_cast<double>(std::numeric_limits<Rep>::lowest())
+                    || whole >= std::ldexp(1.0, std::numeric_limits<Rep>::digits))
+                {
+                    return std::unexpected(value);
+                }
+                count = whole;
+            }
+            return std::chrono::duration<Rep, Period>{static_cast<Rep>(count)};
+        }
+
+    private:
+        // whole * num / den, if that is a whole number Rep can hold.
+        static auto scale_exactly(Rep whole, int64_t num, int64_t den) -> std::optional<Rep>
+        {
+            if (whole == 0)
+            {
+                return Rep{};
+            }
+            if (!std::in_range<Rep>(num) || !std::in_range<Rep>(den) || whole % static_cast<Rep>(den) != 0)
+            {
+                return std::nullopt;
+            }
+            auto periods = static_cast<Rep>(whole / static_cast<Rep>(den));
+            auto factor  = static_cast<Rep>(num);
+            if (periods > std::numeric_limits<Rep>::max() / factor || periods < std::numeric_limits<Rep>::lowest() / factor)
+            {
+                return std::nullopt;
+            }
+            return static_cast<Rep>(periods * factor);
+        }
+    };
+
+    // The std::complex stream format: "re", "(re)" or "(re, im)".
+    template<typename T>
+    struct ParseTraits<std::complex<T>>
+    {
+        static auto parse(str_v value) -> std::expected<std::complex<T>, str_v>
+        {
+            str_v parts = value;
+            if (value.starts_with('('))
+            {
+                if (!value.ends_with(')'))
+                {
+                    return std::unexpected(value);
+                }
+                parts = value.substr(1, value.length() - 2);
+            }
+            auto re_im   = split_once(parts, ","sv);
+            str_v real   = trim(re_im ? std::get<0>(*re_im) : parts);
+            auto re      = parse_value<T>(real);
+            if (!re)
+            {
+                return std::unexpected(re.error());
+            }
+            if (!re_im)
+            {
+                return std::complex<T>{re.value(), T{}};
+            }
+            return parse_value<T>(trim(std::get<1>(*re_im))).transform([&](T im){return std::complex<T>{re.value(), im};});
+        }
+    };
+
+    // The tokens of line that do not parse as T, joined like join_bad_tokens does for numbers.
+    template<Parsable T>
+    auto join_bad_values(str_v line, str_v delim) -> std::string
+    {
+        std::string joined{};
+        for_each_token(line, delim, [&](str_v token, size_t)
+        {
+            if (!parse_value<T>(token))
+            {
+                joined += joined.empty() ? ""sv : ", "sv;
+                joined += token;
+            }
+        });
+        return joined;
+    }
+
+    // Exactly N tokens of line split on delim, without allocating. On failure returns the first malformed token,
+    // the tokens past the N-th, or the whole line when there are fewer than N.
+    template<Parsable T, size_t N>
+    constexpr auto try_parse_array(str_v line, str_v delim) -> std::expected<std::array<T, N>, str_v>
+    {
+        std::array<T, N> values{};
+        size_t count = 0;
+        std::optional<str_v> bad{};
+        for_each_token(line, delim, [&](str_v token, size_t offset)
+        {
+            if (bad.has_value())
+            {
+                return;
+            }
+            if (count == N)
+            {
+                bad = line.substr(offset);
+                return;
+            }
+            auto value = parse_value<T>(token);
+            if (!value)
+            {
+                bad = value.error();
+                return;
+            }
+            values[count++] = std::move(value.value());
+        });
+        if (bad.has_value() || count < N)
+        {
+            return std::unexpected(bad.value_or(line));
+        }
+        return values;
+    }
+}
+#endif
@@ -1,10 +1,17 @@
 #ifndef PARAMETER_READER_HPP
 #define PARAMETER_READER_HPP
 
+#include <algorithm>
+#include <array>
+#include <filesystem>
 #include <iostream>
 #include <istream>
 #include <ostream>
 #include <fstream>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+#include <thread>
 #include <unordered_map>
 #include <ranges>
 #include <print>
@@ -15,9 +22,20 @@
 
 #include "reader_error.hpp"
 #include "parameter_parser/utilities.hpp"
+#include "parameter_parser/source_buffer.hpp"
+#include "parameter_parser/frozen_index.hpp"
+#include "parameter_parser/instrumentation.hpp"
+#include "parameter_parser/matrix.hpp"
+#include "parameter_parser/sweep.hpp"
+#include "parameter_parser/schema.hpp"
+#include "parameter_parser/batch.hpp"
+#include "parameter_parser/mode.hpp"
+#include "parameter_parser/external_array.hpp"
+#include "parameter_parser/parse_traits.hpp"
+#include "parameter_parser/instantiations.hpp"
 
 using str_v = std::string_view;
-using ParameterMap = std::unordered_map<std::string, std::string>;
+using ParameterMap = std::pmr::unordered_map<str_v, str_v>; // key/value slices of the reader's SourceBuffer
 
 
 
@@ -27,149 +45,901 @@ namespace parameter_parser::reader
     using utilities::trim;
     using utilities::parse_num_handled;
     using utilities::try_parse_vec;
+    using utilities::Matrix;
+    using utilities::MatrixShape;
+    using utilities::Sweep;
     using namespace std::string_view_literals;
 
-    enum class Mode
+    enum class Load
     {
-        Permissive,
-        Strict,
+        Buffered, // read the file into one owned allocation
+        Mapped,   // memory-map the file (falls back to Buffered without mmap support)
     };
-    auto exit_if_err(ReaderError&& error) -> ReaderError 
+    inline auto exit_if_err(ReaderError&& error) -> ReaderError 
     {
         error.from = parameter_parser::map_try_parse_to_parse_or_exit(error.from);
         std::cerr << "Exiting with ParameterParserError: " << error;
         exit(EXIT_FAILURE);
         return error;
     }
+    inline auto exit_if_errs(std::vector<ReaderError>&& errors) -> std::vector<ReaderError>
+    {
+        for (auto& error : errors)
+        {
+            error.from = parameter_parser::map_try_parse_to_parse_or_exit(error.from);
+            std::cerr << "ParameterParserError: " << error << '\n';
+        }
+        std::cerr << "Exiting with " << errors.size() << " ParameterParserError(s)";
+        exit(EXIT_FAILURE);
+        return errors;
+    }
+
+    class BinaryCache;
+    class LayeredReader;
+    class Section;
 
     class ParameterReader
     {
+        friend class BinaryCache;
+        friend class LayeredReader;
+
+        std::shared_ptr<const SourceBuffer> m_source{};
         ParameterMap m_map{};
-        std::string m_buffer{};
-        ParameterReader(ParameterMap&& map)
-            : m_map{std::move(map)} // call the unordered_map move constructor
+        std::shared_ptr<const FrozenIndex> m_frozen{};
+        std::shared_ptr<const void> m_section_keys{}; // owns the "section.key" keys, which are not slices of the source
+        LazyArrayFiles m_arrays{}; // the "@path" binary files, see try_get_array
+        bool m_source_is_text{true}; // false when m_source holds a BinaryCache rather than the parameter file
+#ifdef PARAMETER_PARSER_INSTRUMENTATION
+        std::shared_ptr<AccessStats> m_stats{};
+#endif
+        // directory: where the relative "@path" values point, that of the parameter file (empty: the working directory).
+        ParameterReader(std::shared_ptr<const SourceBuffer> source, ParameterMap&& map, str_v directory = {})
+            : m_source{std::move(source)}, m_map{std::move(map)}, m_arrays{directory, m_map.get_allocator().resource()} // copies share the immutable source
         {   
+#ifdef PARAMETER_PARSER_INSTRUMENTATION
+            m_stats = std::make_shared<AccessStats>(m_map);
+#endif
         }
     private:
-        static auto build_from_ifstream(std::ifstream& parameter_file, str_v delimiter, Mode mode) -> std::expected<ParameterReader, ReaderError>
+        static auto has_section_headers(str_v text) -> bool
+        {
+            for (size_t bracket = text.find('['); bracket != str_v::npos; bracket = text.find('[', bracket + 1))
+            {
+                size_t before = (bracket == 0) ? str_v::npos : text.find_last_not_of(' ', bracket - 1);
+                if (before == str_v::npos || text[before] == '\n')
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+        // Parses every line of text into map; the first occurrence of a key wins.
+        // Keys following a "[section]" line are stored as "section.key", written into section_keys; "[]" ends the section.
+        // Without section_keys (parallel chunks, which never contain headers) such lines are malformed.
+        // A Strict-mode error points at its line in text; the caller attaches the source that owns it.
+        static auto parse_lines(str_v text, str_v delimiter, Mode mode, ParameterMap& map,
+                                std::pmr::memory_resource* section_keys = nullptr) -> std::expected<void, ReaderError>
         {
-            std::unordered_map<std::string, std::string> parameter_map{};
-            std::string buffer{};
-            while (std::getline(parameter_file, buffer))
+            map.reserve(map.size() + static_cast<size_t>(std::ranges::count(text, '\n')) + 1);
+            str_v section{};
+            str_v remaining = text;
+            while (!remaining.empty())
             {
-                auto key_val = split_once(buffer, delimiter);
-                if (!key_val.has_value() && mode == Mode::Strict)
+                size_t end = std::min(remaining.find('\n'), remaining.length());
+                str_v line = remaining.substr(0, end);
+                remaining.remove_prefix(std::min(end + 1, remaining.length()));
+
+                auto key_val = split_once(line, delimiter);
+                if (auto header = utilities::section_header(line, delimiter); header.has_value() && section_keys != nullptr)
+                {
+                    section = header.value();
+                }
+                else if (!key_val.has_value() && mode == Mode::Strict)
                 {
-                    ReaderError error{.args = buffer, .from = ReaderError::From::build, .kind = ReaderError::Kind::ParseError};
+                    ReaderError error{.args = ErrorArgs::slice(line), .from = ReaderError::From::build, .kind = ReaderError::Kind::ParseError};
                     return std::unexpected(error);
                 }
                 else if (key_val.has_value())
                 {
                     auto[key, value] = key_val.value();
-                    parameter_map.emplace(trim(key), trim(value));
+                    map.emplace(section.empty() ? trim(key) : qualified_key(section, trim(key), *section_keys), trim(value));
+                }
+            }
+            return {};
+        }
+        // Writes "section.key" into storage.
+        static auto qualified_key(str_v section, str_v key, std::pmr::memory_resource& storage) -> str_v
+        {
+            size_t length = section.length() + 1 + key.length();
+            auto* bytes   = static_cast<char*>(storage.allocate(length, 1));
+            char* dot     = std::ranges::copy(section, bytes).out;
+            *dot          = '.';
+            std::ranges::copy(key, dot + 1);
+            return str_v{bytes, length};
+        }
+        // Splits text into newline-aligned chunks parsed on their own thread, then splices the chunk maps together in file order,
+        // so duplicates and Strict-mode errors resolve exactly as in a sequential parse.
+        static auto parse_parallel(str_v text, str_v delimiter, Mode mode, size_t threads) -> std::expected<ParameterMap, ReaderError>
+        {
+            std::vector<str_v> chunks{};
+            size_t begin = 0;
+            for (size_t t = 1; t <= threads && begin < text.length(); t++)
+            {
+                size_t end = (t == threads) ? text.length() : std::max(begin, text.length() / threads * t);
+                end        = std::min(text.find('\n', end), text.length() - 1) + 1;
+                chunks.push_back(text.substr(begin, end - begin));
+                begin = end;
+            }
+
+            std::vector<ParameterMap> maps(chunks.size());
+            std::vector<std::expected<void, ReaderError>> results(chunks.size());
+            {
+                std::vector<std::jthread> workers{};
+                for (size_t t = 0; t < chunks.size(); t++)
+                {
+                    workers.emplace_back([&, t]{results[t] = parse_lines(chunks[t], delimiter, mode, maps[t]);});
+                }
+            }
+            for (auto& result : results) // the first failing chunk holds the earliest bad line
+            {
+                if (!result)
+                {
+                    return std::unexpected(std::move(result.error()));
                 }
             }
-            return ParameterReader{std::move(parameter_map)};
+            ParameterMap parameter_map = maps.empty() ? ParameterMap{} : std::move(maps.front());
+            for (size_t t = 1; t < maps.size(); t++)
+            {
+                parameter_map.merge(maps[t]); // moves nodes, keeps the entries already present
+            }
+            return parameter_map;
         }
+        static auto build_from_source(SourceBuffer&& buffer, str_v delimiter, Mode mode, size_t threads = 1,
+                                      std::pmr::memory_resource* resource = std::pmr::get_default_resource(), str_v directory = {}) -> std::expected<ParameterReader, ReaderError>
+        {
+            constexpr size_t min_bytes_per_thread = 64 * 1024;
 
-    public:
-        static auto build(const char* file_path, str_v delimiter, Mode mode = Mode::Strict) -> std::expected<ParameterReader, ReaderError>
+            std::shared_ptr<const SourceBuffer> source = std::allocate_shared<SourceBuffer>(std::pmr::polymorphic_allocator<>{resource}, std::move(buffer));
+            bool sections = has_section_headers(source->view()); // a chunk would not know the section it starts in
+            threads       = sections ? 1 : std::min(threads, source->size() / min_bytes_per_thread);
+            auto with_source = [&](ReaderError&& error)
+            {
+                error.source = ErrorSource{.owner = source, .text = source->view()};
+                return std::move(error);
+            };
+            if (threads > 1)
+            {
+                return parse_parallel(source->view(), delimiter, mode, threads).transform_error(with_source).transform([&](ParameterMap&& parameter_map)
+                {
+                    return ParameterReader{std::move(source), std::move(parameter_map), directory};
+                });
+            }
+            ParameterMap parameter_map{resource};
+            std::shared_ptr<std::pmr::monotonic_buffer_resource> section_keys{};
+            if (sections)
+            {
+                section_keys = std::allocate_shared<std::pmr::monotonic_buffer_resource>(std::pmr::polymorphic_allocator<>{resource}, resource);
+            }
+            if (auto parsed = parse_lines(source->view(), delimiter, mode, parameter_map, section_keys.get()); !parsed)
+            {
+                return std::unexpected(with_source(std::move(parsed.error())));
+            }
+            ParameterReader reader{std::move(source), std::move(parameter_map), directory};
+            reader.m_section_keys = std::move(section_keys);
+            return reader;
+        }
+        static auto build_from_path(const char* file_path, str_v delimiter, Mode mode, Load load, size_t threads = 1,
+                                    std::pmr::memory_resource* resource = std::pmr::get_default_resource()) -> std::expected<ParameterReader, ReaderError>
         {
-            std::ifstream parameter_file{file_path};
-            if (!parameter_file.is_open())
+            auto buffer = (load == Load::Mapped) ? SourceBuffer::map_file(file_path, resource) : SourceBuffer::read_file(file_path, resource);
+            if (!buffer.has_value())
             {
                 ReaderError error{.args = file_path, .from = ReaderError::From::build, .kind = ReaderError::Kind::FileError};
                 return std::unexpected(error);
             }
+            return build_from_source(std::move(buffer.value()), delimiter, mode, threads, resource, std::filesystem::path{file_path}.parent_path().string());
+        }
+        // Single probe, no allocation: the map is keyed by str_v so the caller's key is hashed as-is.
+        auto find(str_v key) const -> const str_v*
+        {
+            if (m_frozen)
+            {
+                return m_frozen->find(key);
+            }
+            auto it = m_map.find(key);
+            return (it != m_map.end()) ? &it->second : nullptr;
+        }
+        // find() plus, when PARAMETER_PARSER_INSTRUMENTATION is defined, a hit or miss count for the accessor.
+        auto lookup(str_v key, [[maybe_unused]] Access access) const -> const str_v*
+        {
+            const str_v* value = find(key);
+#ifdef PARAMETER_PARSER_INSTRUMENTATION
+            m_stats->record_lookup(key, access, value != nullptr);
+#endif
+            return value;
+        }
+#ifdef PARAMETER_PARSER_INSTRUMENTATION
+        auto time_parse(str_v key, str_v value) const -> ParseTimer
+        {
+            return ParseTimer{*m_stats, key, value};
+        }
+#else
+        static auto time_parse(str_v, str_v) -> int
+        {
+            return 0;
+        }
+#endif
+        template<typename F>
+        auto for_each_entry(F&& visitor) const -> void
+        {
+            if (m_frozen)
+            {
+                for (const auto& entry : m_frozen->entries())
+                {
+                    visitor(entry.key, entry.value);
+                }
+                return;
+            }
+            for (const auto& [key, value] : m_map)
+            {
+                visitor(key, value);
+            }
+        }
 
-            return build_from_ifstream(parameter_file,delimiter, mode);
+        // Errors keep the source alive and point into it, so reporting one copies no text.
+        auto error_source() const -> ErrorSource
+        {
+            return ErrorSource{.owner = m_source, .text = m_source_is_text ? m_source->view() : str_v{}};
         }
-        static auto build(const std::string& file_path, str_v delimiter, Mode mode = Mode::Strict) -> std::expected<ParameterReader, ReaderError>
+        // The accessors below take the value already looked up for key (nullptr: key is missing), so that LayeredReader
+        // finds a key once across all its layers.
+
+        // The elements of the "@path" file referenced by key, with their shape ("[n]" or none: n x 1).
+        template<typename T>
+        auto map_array(str_v key, const str_v* value) const -> std::expected<std::pair<std::span<const T>, MatrixShape>, ReaderError>
         {
-            std::ifstream parameter_file{file_path};
-            if (!parameter_file.is_open())
+            if (value == nullptr)
             {
-                ReaderError error{.args = file_path, .from = ReaderError::From::build, .kind = ReaderError::Kind::FileError};
+                ReaderError error{.args = std::string{key}, .from = ReaderError::From::try_get_array, .kind = ReaderError::Kind::KeyError};
+                return std::unexpected(error);
+            }
+            auto parse_error = [&](str_v bad)
+            {
+                return ReaderError{.args = ErrorArgs::slice(bad), .from = ReaderError::From::try_get_array, .kind = ReaderError::Kind::ParseError, .source = error_source()};
+            };
+            auto ref = utilities::parse_array_ref(*value);
+            if (!ref.has_value())
+            {
+                return std::unexpected(parse_error(ref.error()));
+            }
+            if (ref->dtype.has_value() && ref->dtype != utilities::dtype_of<T>())
+            {
+                return std::unexpected(parse_error(*value));
+            }
+            ArrayFiles& arrays       = m_arrays.get();
+            std::string path         = arrays.resolve(ref->path);
+            const SourceBuffer* file = arrays.map(path);
+            if (file == nullptr)
+            {
+                ReaderError error{.args = std::move(path), .from = ReaderError::From::try_get_array, .kind = ReaderError::Kind::FileError};
                 return std::unexpected(error);
             }
-            return build_from_ifstream(parameter_file,delimiter, mode);
+            str_v bytes       = file->view();
+            size_t count      = bytes.size() / sizeof(T);
+            MatrixShape shape = ref->shape.value_or(MatrixShape{.rows = count, .cols = 1});
+            if (bytes.size() % sizeof(T) != 0 || shape.rows * shape.cols != count || reinterpret_cast<std::uintptr_t>(bytes.data()) % alignof(T) != 0)
+            {
+                return std::unexpected(parse_error(*value));
+            }
+            return std::pair{std::span<const T>{reinterpret_cast<const T*>(bytes.data()), count}, shape};
         }
-        static auto build(str_v file_path, str_v delimiter, Mode mode = Mode::Strict) -> std::expected<ParameterReader, ReaderError>
+        // Hands each number of value to push(T), which returns false once there is no room left. The bad tokens are not
+        // collected: the error keeps the whole value and only lists them if it is printed.
+        template<typename T>
+        auto parse_sweep_value(str_v value, ReaderError::From from) const -> std::expected<Sweep<T>, ReaderError>
         {
-            std::ifstream parameter_file{file_path.data()};
-            if (!parameter_file.is_open())
+            return utilities::try_parse_sweep<T>(value).transform_error([&](str_v bad)
             {
-                ReaderError error{.args = std::string{file_path}, .from = ReaderError::From::build, .kind = ReaderError::Kind::FileError};
-                return std::unexpected(error);
+                return ReaderError{.args = ErrorArgs::slice(bad), .from = from, .kind = ReaderError::Kind::ParseError, .source = error_source()};
+            });
+        }
+        template<typename T, typename Push>
+        auto parse_vector_value(str_v value, str_v delim, Push&& push) const -> std::expected<void, ReaderError>
+        {
+            if constexpr (utilities::Number<T>)
+            {
+                if (utilities::is_sweep(value, delim))
+                {
+                    return parse_sweep_value<T>(value, ReaderError::From::try_parse_vec).and_then([&](const Sweep<T>& sweep) -> std::expected<void, ReaderError>
+                    {
+                        for (T number : sweep)
+                        {
+                            if (!push(number))
+                            {
+                                return std::unexpected(ReaderError{.args = ErrorArgs::slice(value), .from = ReaderError::From::try_parse_vec, .kind = ReaderError::Kind::ParseError, .source = error_source()});
+                            }
+                        }
+                        return {};
+                    });
+                }
+            }
+            bool malformed = false;
+            bool full      = false;
+            str_v overflow{};
+            utilities::for_each_token(value, delim, [&](str_v token, size_t offset)
+            {
+                auto result = utilities::parse_value<T>(token);
+                if (!result)
+                {
+                    malformed = true;
+                }
+                else if (!malformed && !full && !push(result.value()))
+                {
+                    full     = true;
+                    overflow = value.substr(offset);
+                }
+            });
+            if (malformed)
+            {
+                auto join = []
+                {
+                    if constexpr (utilities::Number<T>)
+                    {
+                        return &utilities::join_bad_tokens<T>;
+                    }
+                    else
+                    {
+                        return &utilities::join_bad_values<T>;
+                    }
+                }();
+                auto args = ErrorArgs::deferred(value, delim, join);
+                return std::unexpected(ReaderError{.args = std::move(args), .from = ReaderError::From::try_parse_vec, .kind = ReaderError::Kind::ParseError, .source = error_source()});
+            }
+            if (full)
+            {
+                return std::unexpected(ReaderError{.args = ErrorArgs::slice(overflow), .from = ReaderError::From::try_parse_vec, .kind = ReaderError::Kind::ParseError, .source = error_source()});
+            }
+            return {};
+        }
+        template<typename Vector>
+        auto parse_vector_as(str_v key, const str_v* value, str_v delim, Vector&& values) const -> std::expected<Vector, ReaderError>
+        {
+            if (value == nullptr)
+            {
+                return std::unexpected(missing_vector_key(key));
             }
-            return build_from_ifstream(parameter_file,delimiter, mode);
+            [[maybe_unused]] auto timer = time_parse(key, *value);
+            if constexpr (utilities::Number<typename Vector::value_type>)
+            {
+                if (utilities::is_sweep(*value, delim)) // materialized with a single allocation
+                {
+                    return parse_sweep_value<typename Vector::value_type>(*value, ReaderError::From::try_parse_vec).and_then([&](const auto& sweep) -> std::expected<Vector, ReaderError>
+                    {
+                        if (!utilities::append_sweep(sweep, values))
+                        {
+                            return std::unexpected(ReaderError{.args = ErrorArgs::slice(*value), .from = ReaderError::From::try_parse_vec, .kind = ReaderError::Kind::ParseError, .source = error_source()});
+                        }
+                        return std::move(values);
+                    });
+                }
+            }
+            auto parsed = parse_vector_value<typename Vector::value_type>(*value, delim, [&](auto number)
+            {
+                values.push_back(number);
+                return true;
+            });
+            return parsed.transform([&]{return std::move(values);});
+        }
+        static auto missing_vector_key(str_v key) -> ReaderError
+        {
+            return ReaderError{.args = std::string{key}, .from = ReaderError::From::try_parse_vec, .kind = ReaderError::Kind::KeyError};
+        }
+        template<typename V, typename Parse>
+        auto parse_matrix_as(str_v key, const str_v* value, Parse&& parse) const -> std::expected<V, ReaderError>
+        {
+            if (value == nullptr)
+            {
+                return std::unexpected(ReaderError{.args = std::string{key}, .from = ReaderError::From::try_parse_matrix, .kind = ReaderError::Kind::KeyError});
+            }
+            [[maybe_unused]] auto timer = time_parse(key, *value);
+            return parse(*value).transform_error([&](utilities::TokenError error) // points at the bad number or ragged row
+            {
+                return ReaderError{.args = ErrorArgs::slice(error.token), .from = ReaderError::From::try_parse_matrix, .kind = ReaderError::Kind::ParseError, .source = error_source()};
+            });
         }
 
         template<typename T>
-        auto try_parse_num(str_v key) -> std::expected<T, ReaderError>
-            requires std::is_integral_v<T> || std::is_floating_point_v<T>
+        auto parse_num_as(str_v key, const str_v* value) const -> std::expected<T, ReaderError>
         {
-            m_buffer = key;
-            if (!m_map.contains(m_buffer))
+            if (value == nullptr)
             {
-                ReaderError error{.args = m_buffer, .from = ReaderError::From::try_parse_num, .kind = ReaderError::Kind::KeyError};
+                ReaderError error{.args = std::string{key}, .from = ReaderError::From::try_parse_num, .kind = ReaderError::Kind::KeyError};
                 return std::unexpected(error);
             }
-            const auto& value = m_map.at(m_buffer);
-            auto result       = parse_num_handled<T>(value);
+            [[maybe_unused]] auto timer = time_parse(key, *value);
+            auto result = parse_num_handled<T>(*value);
             if(!result)
             {
-                ReaderError error{.args = std::string{result.error()}, .from = ReaderError::From::try_parse_num, .kind = ReaderError::Kind::ParseError};
+                ReaderError error{.args = ErrorArgs::slice(result.error()), .from = ReaderError::From::try_parse_num, .kind = ReaderError::Kind::ParseError, .source = error_source()};
                 return std::unexpected(error);
             }
 
             return result.value();
         }
+        template<typename T>
+        auto parse_value_as(str_v key, const str_v* value) const -> std::expected<T, ReaderError>
+        {
+            if (value == nullptr)
+            {
+                ReaderError error{.args = std::string{key}, .from = ReaderError::From::try_parse, .kind = ReaderError::Kind::KeyError};
+                return std::unexpected(error);
+            }
+            [[maybe_unused]] auto timer = time_parse(key, *value);
+            return utilities::parse_value<T>(*value).transform_error([&](str_v bad)
+            {
+                return ReaderError{.args = ErrorArgs::slice(bad), .from = ReaderError::From::try_parse, .kind = ReaderError::Kind::ParseError, .source = error_source()};
+            });
+        }
+        template<typename T, size_t N>
+        auto parse_array_as(str_v key, const str_v* value, str_v delim) const -> std::expected<std::array<T, N>, ReaderError>
+        {
+            if (value == nullptr)
+            {
+                return std::unexpected(missing_vector_key(key));
+            }
+            [[maybe_unused]] auto timer = time_parse(key, *value);
+            return utilities::try_parse_array<T, N>(*value, delim).transform_error([&](str_v bad)
+            {
+                return ReaderError{.args = ErrorArgs::slice(bad), .from = ReaderError::From::try_parse_vec, .kind = ReaderError::Kind::ParseError, .source = error_source()};
+            });
+        }
+        template<typename T>
+        auto parse_sweep_as(str_v key, const str_v* value) const -> std::expected<Sweep<T>, ReaderError>
+        {
+            if (value == nullptr)
+            {
+                ReaderError error{.args = std::string{key}, .from = ReaderError::From::try_parse_sweep, .kind = ReaderError::Kind::KeyError};
+                return std::unexpected(error);
+            }
+            [[maybe_unused]] auto timer = time_parse(key, *value);
+            return parse_sweep_value<T>(*value, ReaderError::From::try_parse_sweep);
+        }
+        static auto copy_str(str_v key, const str_v* value) -> std::expected<std::string, ReaderError>
+        {
+            if (value == nullptr)
+            {
+                ReaderError error{.args = std::string{key}, .from = ReaderError::From::try_parse_str, .kind = ReaderError::Kind::KeyError};
+                return std::unexpected(error);
+            }
+            return std::string{*value};
+        }
+
+    public:
+        // The file bytes, the map nodes and a later freeze() index are allocated from resource, which must outlive
+        // the reader and its copies (eg: a std::pmr::monotonic_buffer_resource releasing a whole parameter set at once).
+        // Copies of the reader allocate their own map from the default resource.
+        static auto build(const char* file_path, str_v delimiter, Mode mode = Mode::Strict, Load load = Load::Buffered,
+                          std::pmr::memory_resource* resource = std::pmr::get_default_resource()) -> std::expected<ParameterReader, ReaderError>
+        {
+            return build_from_path(file_path, delimiter, mode, load, 1, resource);
+        }
+        static auto build(const std::string& file_path, str_v delimiter, Mode mode = Mode::Strict, Load load = Load::Buffered,
+                          std::pmr::memory_resource* resource = std::pmr::get_default_resource()) -> std::expected<ParameterReader, ReaderError>
+        {
+            return build_from_path(file_path.c_str(), delimiter, mode, load, 1, resource);
+        }
+        static auto build(str_v file_path, str_v delimiter, Mode mode = Mode::Strict, Load load = Load::Buffered,
+                          std::pmr::memory_resource* resource = std::pmr::get_default_resource()) -> std::expected<ParameterReader, ReaderError>
+        {
+            return build_from_path(std::string{file_path}.c_str(), delimiter, mode, load, 1, resource); // a view need not be null-terminated
+        }
+        // Parses text in place without copying it: text must outlive the reader, its copies and the errors it returns.
+        static auto build_from_buffer(str_v text, str_v delimiter, Mode mode = Mode::Strict,
+                                      std::pmr::memory_resource* resource = std::pmr::get_default_resource()) -> std::expected<ParameterReader, ReaderError>
+        {
+            return build_from_source(SourceBuffer::borrow(text), delimiter, mode, 1, resource);
+        }
+        // Reads the stream to its end (eg: std::cin); a stream that goes bad is a FileError.
+        static auto build_from_stream(std::istream& stream, str_v delimiter, Mode mode = Mode::Strict,
+                                      std::pmr::memory_resource* resource = std::pmr::get_default_resource()) -> std::expected<ParameterReader, ReaderError>
+        {
+            auto buffer = SourceBuffer::read_stream(stream, resource);
+            if (!buffer.has_value())
+            {
+                ReaderError error{.args = "<stream>", .from = ReaderError::From::build, .kind = ReaderError::Kind::FileError};
+                return std::unexpected(error);
+            }
+            return build_from_source(std::move(buffer.value()), delimiter, mode, 1, resource);
+        }
+#ifdef PARAMETER_PARSER_HAS_MMAP
+        // Reads an open descriptor (eg: a pipe or STDIN_FILENO) to its end, or maps it with Load::Mapped when it is a
+        // regular file. The descriptor is not closed.
+        static auto build_from_fd(int fd, str_v delimiter, Mode mode = Mode::Strict, Load load = Load::Buffered,
+                                  std::pmr::memory_resource* resource = std::pmr::get_default_resource()) -> std::expected<ParameterReader, ReaderError>
+        {
+            auto buffer = (load == Load::Mapped) ? SourceBuffer::map_fd(fd, resource) : SourceBuffer::read_fd(fd, resource);
+            if (!buffer.has_value())
+            {
+                ReaderError error{.args = std::format("file descriptor {}", fd), .from = ReaderError::From::build, .kind = ReaderError::Kind::FileError};
+                return std::unexpected(error);
+            }
+            return build_from_source(std::move(buffer.value()), delimiter, mode, 1, resource);
+        }
+#endif
+        // Parses the file on several threads (0: one per hardware thread). Small files are parsed sequentially.
+        // Results match build(): the first occurrence of a duplicated key wins and Strict mode reports the earliest bad line.
+        static auto build_parallel(const std::string& file_path, str_v delimiter, size_t threads = 0, Mode mode = Mode::Strict, Load load = Load::Mapped) -> std::expected<ParameterReader, ReaderError>
+        {
+            if (threads == 0)
+            {
+                threads = std::max(1u, std::thread::hardware_concurrency());
+            }
+            return build_from_path(file_path.c_str(), delimiter, mode, load, threads);
+        }
+
+        // Replaces the hash map by an immutable perfect-hash index for faster lookups.
+        // Not thread-safe: freeze before sharing the reader between threads.
+        auto freeze() -> ParameterReader&
+        {
+            if (!m_frozen)
+            {
+                auto* resource = m_map.get_allocator().resource();
+                m_frozen = std::allocate_shared<FrozenIndex>(std::pmr::polymorphic_allocator<>{resource}, FrozenIndex::build(m_map, resource));
+                m_map    = ParameterMap{resource};
+            }
+            return *this;
+        }
+        auto is_frozen() const -> bool
+        {
+            return m_frozen != nullptr;
+        }
+        using Entry = FrozenIndex::Entry;
+
+        // The entries whose key starts with prefix, sorted by key: O(log n + k) once frozen, a scan of every entry otherwise.
+        auto entries_with_prefix(str_v prefix) const -> std::vector<Entry>
+        {
+            std::vector<Entry> entries{};
+            if (m_frozen)
+            {
+                std::ranges::copy(m_frozen->with_prefix(prefix), std::back_inserter(entries));
+                return entries;
+            }
+            for_each_entry([&](str_v key, str_v value)
+            {
+                if (key.starts_with(prefix))
+                {
+                    entries.push_back(Entry{.key = key, .value = value});
+                }
+            });
+            std::ranges::sort(entries, {}, &Entry::key);
+            return entries;
+        }
+        // The keys under "name.", eg: those of an INI "[name]" section, read without their prefix. See Section.
+        auto section(str_v name) const -> Section;
+
+#ifdef PARAMETER_PARSER_INSTRUMENTATION
+        // Lookup counts, parse times and never-accessed keys, eg: reader.access_stats().write_report(std::cerr).
+        auto access_stats() const -> const AccessStats&
+        {
+            return *m_stats;
+        }
+#endif
+
+        template<typename T>
+        auto try_parse_num(str_v key) const -> std::expected<T, ReaderError>
+            requires std::is_integral_v<T> || std::is_floating_point_v<T>
+        {
+            return parse_num_as<T>(key, lookup(key, Access::try_parse_num));
+        }
 template<typename T>
-        auto parse_num_or_exit(str_v key) -> T
+        auto parse_num_or_exit(str_v key) const -> T
             requires std::is_integral_v<T> || std::is_floating_point_v<T>
         {
             return try_parse_num<T>(key).transform_error(exit_if_err).value();
 
         }
+        // Any type with a utilities::ParseTraits specialization: numbers, bool, enums with EnumNames, std::chrono durations,
+        // std::complex or a user type. Parsed straight from the stored view.
+        template<utilities::Parsable T>
+        auto try_parse(str_v key) const -> std::expected<T, ReaderError>
+        {
+            return parse_value_as<T>(key, lookup(key, Access::try_parse));
+        }
+        template<utilities::Parsable T>
+        auto parse_or_exit(str_v key) const -> T
+        {
+            return try_parse<T>(key).transform_error(exit_if_err).value();
+        }
         template<typename T>
-        auto try_parse_vector(str_v key, str_v delim) -> std::expected<std::vector<T>, ReaderError>
-            requires std::is_integral_v<T> || std::is_floating_point_v<T>
+        auto try_parse_vector(str_v key, str_v delim) const -> std::expected<std::vector<T>, ReaderError>
+            requires utilities::Parsable<T>
+        {
+            return parse_vector_as(key, lookup(key, Access::try_parse_vector), delim, std::vector<T>{});
+        }
+        // Allocates the values from resource.
+        template<typename T>
+        auto try_parse_vector(str_v key, str_v delim, std::pmr::memory_resource* resource) const -> std::expected<std::pmr::vector<T>, ReaderError>
+            requires utilities::Parsable<T>
+        {
+            return parse_vector_as(key, lookup(key, Access::try_parse_vector), delim, std::pmr::vector<T>{resource});
+        }
+        // Parses into caller-owned storage without allocating and returns the number of values written.
+        // Values that do not fit in out are a ParseError.
+        template<typename T>
+        auto try_parse_vector_into(str_v key, str_v delim, std::span<T> out) const -> std::expected<size_t, ReaderError>
+            requires utilities::Parsable<T>
         {
-            m_buffer = key;
-            if (!m_map.contains(m_buffer))
+            const str_v* value = lookup(key, Access::try_parse_vector);
+            if (value == nullptr)
             {
-                ReaderError error{.args = m_buffer, .from = ReaderError::From::try_parse_vec, .kind = ReaderError::Kind::KeyError};
-                return std::unexpected(error);
+                return std::unexpected(missing_vector_key(key));
             }
-            const auto& value = m_map.at(m_buffer);
-            auto result       = try_parse_vec<T>(value, delim).transform_error([](std::string error)
+            [[maybe_unused]] auto timer = time_parse(key, *value);
+            size_t written = 0;
+            return parse_vector_value<T>(*value, delim, [&](T number)
             {
-                ReaderError read_error{.args = error, .from = ReaderError::From::try_parse_vec, .kind = ReaderError::Kind::ParseError};
-                return read_error;
-            });
-            return result;
+                if (written == out.size())
+                {
+                    return false;
+                }
+                out[written++] = number;
+                return true;
+            }).transform([&]{return written;});
+        }
+        // Writes the values through out and returns the iterator past the last one, without allocating.
+        template<typename T, std::output_iterator<const T&> Out>
+        auto try_parse_vector_into(str_v key, str_v delim, Out out) const -> std::expected<Out, ReaderError>
+            requires utilities::Parsable<T>
+        {
+            const str_v* value = lookup(key, Access::try_parse_vector);
+            if (value == nullptr)
+            {
+                return std::unexpected(missing_vector_key(key));
+            }
+            [[maybe_unused]] auto timer = time_parse(key, *value);
+            return parse_vector_value<T>(*value, delim, [&](T number)
+            {
+                *out = number;
+                ++out;
+                return true;
+            }).transform([&]{return std::move(out);});
         }
         template<typename T>
-        auto parse_vector_or_exit(str_v key, str_v delim) -> std::vector<T>
-            requires std::is_integral_v<T> || std::is_floating_point_v<T>
+        auto parse_vector_or_exit(str_v key, str_v delim) const -> std::vector<T>
+            requires utilities::Parsable<T>
         {
             return try_parse_vector<T>(key, delim).transform_error(exit_if_err).value();
         }
-        auto try_get_str(str_v key) -> std::expected<std::string, ReaderError>
+        // Exactly N values, eg: a 3-vector or a 4x4 transform, without allocating. Fewer or more values are a ParseError.
+        template<utilities::Parsable T, size_t N>
+        auto try_parse_array(str_v key, str_v delim) const -> std::expected<std::array<T, N>, ReaderError>
+        {
+            return parse_array_as<T, N>(key, lookup(key, Access::try_parse_vector), delim);
+        }
+        template<utilities::Parsable T, size_t N>
+        auto parse_array_or_exit(str_v key, str_v delim) const -> std::array<T, N>
+        {
+            return try_parse_array<T, N>(key, delim).transform_error(exit_if_err).value();
+        }
+        // Lazy view over a value written as start:step:stop, start:stop or linspace(a, b, n); see utilities::try_parse_sweep.
+        // try_parse_vector also accepts these forms (when delim does not contain ':') and materializes them.
+        template<typename T>
+        auto try_parse_sweep(str_v key) const -> std::expected<Sweep<T>, ReaderError>
+            requires std::is_integral_v<T> || std::is_floating_point_v<T>
+        {
+            return parse_sweep_as<T>(key, lookup(key, Access::try_parse_sweep));
+        }
+        template<typename T>
+        auto parse_sweep_or_exit(str_v key) const -> Sweep<T>
+            requires std::is_integral_v<T> || std::is_floating_point_v<T>
+        {
+            return try_parse_sweep<T>(key).transform_error(exit_if_err).value();
+        }
+        // Row-major matrix written as rows split on row_delim, eg: "1, 0; 0, 1" with ";" and ",".
+        // Rows of different lengths are a ParseError pointing at the first ragged row.
+        template<typename T>
+        auto try_parse_matrix(str_v key, str_v row_delim, str_v col_delim) const -> std::expected<Matrix<T>, ReaderError>
+            requires std::is_integral_v<T> || std::is_floating_point_v<T>
+        {
+            return parse_matrix_as<Matrix<T>>(key, lookup(key, Access::try_parse_matrix), [&](str_v value){return utilities::try_parse_matrix<T>(value, row_delim, col_delim);});
+        }
+        // Same, into caller-owned storage (see utilities::as_mdspan); a matrix larger than out is a ParseError.
+        template<typename T>
+        auto try_parse_matrix_into(str_v key, str_v row_delim, str_v col_delim, std::span<T> out) const -> std::expected<MatrixShape, ReaderError>
+            requires std::is_integral_v<T> || std::is_floating_point_v<T>
+        {
+            return parse_matrix_as<MatrixShape>(key, lookup(key, Access::try_parse_matrix), [&](str_v value){return utilities::try_parse_matrix_into<T>(value, row_delim, col_delim, out);});
+        }
+        template<typename T>
+        auto parse_matrix_or_exit(str_v key, str_v row_delim, str_v col_delim) const -> Matrix<T>
+            requires std::is_integral_v<T> || std::is_floating_point_v<T>
+        {
+            return try_parse_matrix<T>(key, row_delim, col_delim).transform_error(exit_if_err).value();
+        }
+        auto try_get_str(str_v key) const -> std::expected<std::string, ReaderError>
+        {
+            return copy_str(key, lookup(key, Access::try_get_str));
+        }
+        auto get_str_or_exit(str_v key) const -> std::string
+        {
+            return try_get_str(key).transform_error(exit_if_err).value();
+        }
+        // Zero-copy view of a raw binary file named by a value such as "@weights.f32" or "@grid.f64[100, 3]", see
+        // utilities::parse_array_ref. The file is mapped on first use and stays mapped while the reader or a copy lives.
+        // Relative paths are resolved against the directory of the parameter file. A dtype that is not T's, a size that
+        // does not match the shape or a misaligned file is a ParseError, a file that cannot be opened a FileError.
+        template<typename T>
+        auto try_get_array(str_v key) const -> std::expected<std::span<const T>, ReaderError>
+            requires std::is_integral_v<T> || std::is_floating_point_v<T>
+        {
+            return map_array<T>(key, lookup(key, Access::try_get_array)).transform([](const auto& array){return array.first;});
+        }
+        template<typename T>
+        auto get_array_or_exit(str_v key) const -> std::span<const T>
+            requires std::is_integral_v<T> || std::is_floating_point_v<T>
+        {
+            return try_get_array<T>(key).transform_error(exit_if_err).value();
+        }
+#ifdef __cpp_lib_mdspan
+        // Same, as a rows x cols view: the "[rows, cols]" of the value, n x 1 without one.
+        template<typename T>
+        auto try_get_array_mdspan(str_v key) const -> std::expected<utilities::MatrixSpan<const T>, ReaderError>
+            requires std::is_integral_v<T> || std::is_floating_point_v<T>
         {
-            m_buffer = key;
-            if (!m_map.contains(m_buffer))
+            return map_array<T>(key, lookup(key, Access::try_get_array)).transform([](const auto& array){return utilities::as_mdspan(array.first, array.second);});
+        }
+#endif
+
+        // Fills a struct described by a Schema in one pass over the entries, reporting every missing/malformed field.
+        template<typename SchemaT>
+        auto try_bind() const -> std::expected<typename SchemaT::value_type, std::vector<ReaderError>>
+        {
+#ifdef PARAMETER_PARSER_INSTRUMENTATION
+            return SchemaT::bind([this](auto&& visitor)
             {
-                ReaderError error{.args = m_buffer, .from = ReaderError::From::try_parse_str, .kind = ReaderError::Kind::KeyError};
-                return std::unexpected(error);
+                for_each_entry([&](str_v key, str_v value)
+                {
+                    if (SchemaT::contains(key))
+                    {
+                        m_stats->record_lookup(key, Access::try_bind, true);
+                    }
+                    visitor(key, value);
+                });
+            });
+#else
+            return SchemaT::bind([this](auto&& visitor){for_each_entry(visitor);});
+#endif
+        }
+        template<typename SchemaT>
+        auto bind_or_exit() const -> typename SchemaT::value_type
+        {
+            return try_bind<SchemaT>().transform_error(exit_if_errs).value();
+        }
+
+        // Batch lookup returning all values or every error at once, eg:
+        //     auto [tol, weights] = reader.resolve_or_exit(num<double>("tol"), vec<float>("weights", ","));
+        template<typename... Ts>
+        auto try_resolve(const Request<Ts>&... requests) const -> std::expected<std::tuple<Ts...>, std::vector<ReaderError>>
+        {
+            return resolve([this](str_v key){return lookup(key, Access::try_resolve);}, requests...);
+        }
+        template<typename... Ts>
+        auto resolve_or_exit(const Request<Ts>&... requests) const -> std::tuple<Ts...>
+        {
+            return try_resolve(requests...).transform_error(exit_if_errs).value();
+        }
+    };
+
+    // A view of the keys of one section that reads them without their "name." prefix, eg: section.try_parse_num<double>("tol")
+    // reads "solver.tol". It copies nothing from the reader, which must outlive it; results and errors are the reader's.
+    class Section
+    {
+        const ParameterReader* m_reader{};
+        std::string m_prefix{};
+
+        // Calls read with "prefix.key", composed on the stack unless it is long.
+        template<typename Read>
+        auto with_key(str_v key, Read&& read) const
+        {
+            std::array<char, 128> buffer{};
+            if (m_prefix.length() + key.length() <= buffer.size())
+            {
+                auto end = std::ranges::copy(key, std::ranges::copy(m_prefix, buffer.begin()).out).out;
+                return read(str_v{buffer.begin(), end});
             }
-            return m_map.at(m_buffer);
+            std::string qualified = m_prefix + std::string{key};
+            return read(str_v{qualified});
         }
-        auto get_str_or_exit(str_v key) -> std::string
+
+    public:
+        Section(const ParameterReader& reader, str_v name)
+            : m_reader{&reader}, m_prefix{std::string{name} + "."}
         {
-            return try_get_str(key).transform_error(exit_if_err).value();
+        }
+
+        auto name() const -> str_v
+        {
+            return str_v{m_prefix}.substr(0, m_prefix.length() - 1);
+        }
+        // The entries of the section with their full keys, sorted by key.
+        auto entries() const -> std::vector<ParameterReader::Entry>
+        {
+            return m_reader->entries_with_prefix(m_prefix);
+        }
+        auto section(str_v name) const -> Section
+        {
+            return Section{*m_reader, m_prefix + std::string{name}};
+        }
+
+        template<typename T>
+        auto try_parse_num(str_v key) const -> std::expected<T, ReaderError>
+            requires std::is_integral_v<T> || std::is_floating_point_v<T>
+        {
+            return with_key(key, [&](str_v qualified){return m_reader->try_parse_num<T>(qualified);});
+        }
+        template<typename T>
+        auto parse_num_or_exit(str_v key) const -> T
+            requires std::is_integral_v<T> || std::is_floating_point_v<T>
+        {
+            return with_key(key, [&](str_v qualified){return m_reader->parse_num_or_exit<T>(qualified);});
+        }
+        template<typename T>
+        auto try_parse_vector(str_v key, str_v delim) const -> std::expected<std::vector<T>, ReaderError>
+            requires utilities::Parsable<T>
+        {
+            return with_key(key, [&](str_v qualified){return m_reader->try_parse_vector<T>(qualified, delim);});
+        }
+        template<typename T>
+        auto parse_vector_or_exit(str_v key, str_v delim) const -> std::vector<T>
+            requires utilities::Parsable<T>
+        {
+            return with_key(key, [&](str_v qualified){return m_reader->parse_vector_or_exit<T>(qualified, delim);});
+        }
+        template<typename T>
+        auto try_parse_sweep(str_v key) const -> std::expected<Sweep<T>, ReaderError>
+            requires std::is_integral_v<T> || std::is_floating_point_v<T>
+        {
+            return with_key(key, [&](str_v qualified){return m_reader->try_parse_sweep<T>(qualified);});
+        }
+        template<typename T>
+        auto try_parse_matrix(str_v key, str_v row_delim, str_v col_delim) const -> std::expected<Matrix<T>, ReaderError>
+            requires std::is_integral_v<T> || std::is_floating_point_v<T>
+        {
+            return with_key(key, [&](str_v qualified){return m_reader->try_parse_matrix<T>(qualified, row_delim, col_delim);});
+        }
+        auto try_get_str(str_v key) const -> std::expected<std::string, ReaderError>
+        {
+            return with_key(key, [&](str_v qualified){return m_reader->try_get_str(qualified);});
+        }
+        auto get_str_or_exit(str_v key) const -> std::string
+        {
+            return with_key(key, [&](str_v qualified){return m_reader->get_str_or_exit(qualified);});
+        }
+        template<typename T>
+        auto try_get_array(str_v key) const -> std::expected<std::span<const T>, ReaderError>
+            requires std::is_integral_v<T> || std::is_floating_point_v<T>
+        {
+            return with_key(key, [&](str_v qualified){return m_reader->template try_get_array<T>(qualified);});
+        }
+        template<utilities::Parsable T>
+        auto try_parse(str_v key) const -> std::expected<T, ReaderError>
+        {
+            return with_key(key, [&](str_v qualified){return m_reader->template try_parse<T>(qualified);});
+        }
+        template<utilities::Parsable T, size_t N>
+        auto try_parse_array(str_v key, str_v delim) const -> std::expected<std::array<T, N>, ReaderError>
+        {
+            return with_key(key, [&](str_v qualified){return m_reader->template try_parse_array<T, N>(qualified, delim);});
         }
     };
+
+    inline auto ParameterReader::section(str_v name) const -> Section
+    {
+        return Section{*this, name};
+    }
 }
+
+#ifdef PARAMETER_PARSER_COMPILED
+PARAMETER_PARSER_NUM_TYPES(PARAMETER_PARSER_INSTANTIATE, extern)
+#endif
 #endif
\ No newline at end of file
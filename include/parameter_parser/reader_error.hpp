@@ -1,13 +1,104 @@
 #ifndef READER_ERROR_HPP
 #define READER_ERROR_HPP
 
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <optional>
 #include <ostream>
 #include <iostream>
+#include <string>
 #include <string_view>
 #include <format>
 
 namespace parameter_parser
 {
+    // The text of a ReaderError. It is either owned, or a slice of the error's source that is only turned into a string
+    // when it is printed or compared: building such an error copies no text. Short owned texts (eg: most keys) fit in
+    // std::string's inline buffer and do not allocate either.
+    class ErrorArgs
+    {
+    public:
+        // Rebuilds the text of a deferred error from the source slice and the context it was created with.
+        using Expand = std::string (*)(std::string_view slice, std::string_view context);
+
+    private:
+        std::string m_owned{}; // the text itself, or the context of a deferred error
+        std::string_view m_slice{};
+        Expand m_expand{};
+        bool m_is_slice{};
+
+    public:
+        ErrorArgs() = default;
+        ErrorArgs(std::string owned)
+            : m_owned{std::move(owned)}
+        {
+        }
+        ErrorArgs(const char* owned)
+            : m_owned{owned}
+        {
+        }
+        // slice must stay alive as long as the error: it should point into the ReaderError's source.
+        static auto slice(std::string_view slice) -> ErrorArgs
+        {
+            ErrorArgs args{};
+            args.m_slice    = slice;
+            args.m_is_slice = true;
+            return args;
+        }
+        static auto deferred(std::string_view slice, std::string_view context, Expand expand) -> ErrorArgs
+        {
+            ErrorArgs args = ErrorArgs::slice(slice);
+            args.m_owned   = std::string{context};
+            args.m_expand  = expand;
+            return args;
+        }
+
+        // The part of the source the error points at, empty for owned texts.
+        auto source_slice() const -> std::string_view
+        {
+            return m_is_slice ? m_slice : std::string_view{};
+        }
+        auto str() const -> std::string
+        {
+            if (m_expand != nullptr)
+            {
+                return m_expand(m_slice, m_owned);
+            }
+            return m_is_slice ? std::string{m_slice} : m_owned;
+        }
+        friend auto operator==(const ErrorArgs& args, std::string_view text) -> bool
+        {
+            if (args.m_expand == nullptr)
+            {
+                return (args.m_is_slice ? args.m_slice : std::string_view{args.m_owned}) == text;
+            }
+            return args.str() == text;
+        }
+        friend std::ostream& operator<< (std::ostream& out, const ErrorArgs& args)
+        {
+            if (args.m_expand == nullptr)
+            {
+                return out << (args.m_is_slice ? args.m_slice : std::string_view{args.m_owned});
+            }
+            return out << args.str();
+        }
+    };
+
+    // The parameter file text an error points into. owner keeps the bytes alive, so the args slice and location()
+    // stay valid after the reader is gone.
+    struct ErrorSource
+    {
+        std::shared_ptr<const void> owner{};
+        std::string_view text{};
+    };
+
+    struct SourceLocation
+    {
+        size_t line{};   // 1-based
+        size_t column{}; // 1-based, in bytes
+    };
+
     struct ReaderError
     {
         enum class Kind
@@ -25,6 +116,20 @@ namespace parameter_parser
             parse_vec_or_exit,
             parse_str_or_exit,
             build,
+            try_bind,
+            bind_or_exit,
+            try_resolve,
+            resolve_or_exit,
+            write_cache,
+            try_parse_matrix,
+            parse_matrix_or_exit,
+            try_parse_sweep,
+            parse_sweep_or_exit,
+            write,
+            try_get_array,
+            get_array_or_exit,
+            try_parse,
+            parse_or_exit,
         };
         static std::string_view kind_as_str(Kind kind_)
         {
@@ -58,24 +163,69 @@ namespace parameter_parser
                 return "parse_vec_or_exit";
             case From::parse_str_or_exit:
                 return "parse_str_or_exit";
+            case From::try_bind:
+                return "try_bind";
+            case From::bind_or_exit:
+                return "bind_or_exit";
+            case From::try_resolve:
+                return "try_resolve";
+            case From::resolve_or_exit:
+                return "resolve_or_exit";
+            case From::write_cache:
+                return "write_cache";
+            case From::try_parse_matrix:
+                return "try_parse_matrix";
+            case From::parse_matrix_or_exit:
+                return "parse_matrix_or_exit";
+            case From::try_parse_sweep:
+                return "try_parse_sweep";
+            case From::parse_sweep_or_exit:
+                return "parse_sweep_or_exit";
+            case From::write:
+                return "write";
+            case From::try_get_array:
+                return "try_get_array";
+            case From::get_array_or_exit:
+                return "get_array_or_exit";
+            case From::try_parse:
+                return "try_parse";
+            case From::parse_or_exit:
+                return "parse_or_exit";
             default:
                 return "";
             }
         }
         std::string decode() const 
         {
-            return std::format("from: \"{}\", kind: \"{}\", args: \"{}\"", from_as_str(from), kind_as_str(kind), args);
+            return std::format("from: \"{}\", kind: \"{}\", args: \"{}\"", from_as_str(from), kind_as_str(kind), args.str());
         }
         friend std::ostream& operator<< (std::ostream &out, const ReaderError& reader_err)
         {
-            out << reader_err.decode();
+            out << "from: \"" << from_as_str(reader_err.from) << "\", kind: \"" << kind_as_str(reader_err.kind) << "\", args: \"" << reader_err.args << '"';
             return out;
         }
-        std::string args{};
+        // Where args points in the parameter file, computed on demand. Empty when args is not a slice of the file text.
+        auto location() const -> std::optional<SourceLocation>
+        {
+            std::string_view slice = args.source_slice();
+            std::less_equal<const char*> before{};
+            if (source.text.data() == nullptr || slice.data() == nullptr || !before(source.text.data(), slice.data())
+                || !before(slice.data(), source.text.data() + source.text.size()))
+            {
+                return {};
+            }
+            std::string_view preceding = source.text.substr(0, static_cast<size_t>(slice.data() - source.text.data()));
+            size_t line_start          = preceding.rfind('\n');
+            line_start                 = (line_start == std::string_view::npos) ? 0 : line_start + 1;
+            return SourceLocation{.line   = static_cast<size_t>(std::ranges::count(preceding, '\n')) + 1,
+                                  .column = preceding.size() - line_start + 1};
+        }
+        ErrorArgs args{};
         From from{};
         Kind kind{};
+        ErrorSource source{};
     };
-    ReaderError::From map_try_parse_to_parse_or_exit(ReaderError::From from)
+    inline ReaderError::From map_try_parse_to_parse_or_exit(ReaderError::From from)
     {
         switch (from)
         {
@@ -85,6 +235,18 @@ namespace parameter_parser
                 return ReaderError::From::parse_vec_or_exit;
             case ReaderError::From::try_parse_str:
                 return ReaderError::From::parse_str_or_exit;
+            case ReaderError::From::try_bind:
+                return ReaderError::From::bind_or_exit;
+            case ReaderError::From::try_resolve:
+                return ReaderError::From::resolve_or_exit;
+            case ReaderError::From::try_parse_matrix:
+                return ReaderError::From::parse_matrix_or_exit;
+            case ReaderError::From::try_parse_sweep:
+                return ReaderError::From::parse_sweep_or_exit;
+            case ReaderError::From::try_get_array:
+                return ReaderError::From::get_array_or_exit;
+            case ReaderError::From::try_parse:
+                return ReaderError::From::parse_or_exit;
             default:
                 return from;
         }
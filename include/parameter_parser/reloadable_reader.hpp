@@ -0,0 +1,204 @@
+#ifndef RELOADABLE_READER_HPP
+#define RELOADABLE_READER_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <expected>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stop_token>
+#include <string>
+#include <thread>
+
+#include "parameter_parser/reader.hpp"
+#include "parameter_parser/reader_error.hpp"
+
+#if defined(__linux__)
+#define PARAMETER_PARSER_HAS_INOTIFY 1
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace parameter_parser::reader
+{
+    using namespace std::chrono_literals;
+
+    // Publishes a ParameterReader as an immutable snapshot and rebuilds it in the background whenever the file changes
+    // (inotify on Linux, modification-time polling elsewhere). Readers keep the snapshot they loaded alive, so a reload
+    // never invalidates values that are in use. A failed rebuild keeps the previous snapshot and is reported by
+    // last_error() (until the next successful rebuild) and the optional error callback.
+    class ReloadableReader
+    {
+    public:
+        using ErrorCallback = std::function<void(const ReaderError&)>;
+
+    private:
+        std::string m_path{};
+        std::string m_delimiter{};
+        Mode m_mode{};
+        std::chrono::milliseconds m_poll_interval{};
+        ErrorCallback m_on_error{};
+        std::atomic<std::shared_ptr<const ParameterReader>> m_snapshot{};
+        std::atomic<uint64_t> m_generation{0};
+        std::mutex m_reload_mutex{}; // rebuilds run one at a time, so generations are published in order
+        mutable std::mutex m_error_mutex{};
+        std::optional<ReaderError> m_last_error{};
+        std::jthread m_watcher{};
+
+        ReloadableReader(std::string path, str_v delimiter, Mode mode, std::chrono::milliseconds poll_interval, ErrorCallback on_error)
+            : m_path{std::move(path)}, m_delimiter{delimiter}, m_mode{mode}, m_poll_interval{poll_interval}, m_on_error{std::move(on_error)}
+        {
+        }
+
+        auto watch(std::stop_token stop) -> void
+        {
+#ifdef PARAMETER_PARSER_HAS_INOTIFY
+            std::filesystem::path path{m_path};
+            auto directory = path.has_parent_path() ? path.parent_path() : std::filesystem::path{"."};
+            int fd         = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+            // Watch the directory: editors and deployment tools often replace the file by a rename
+            if (fd >= 0 && ::inotify_add_watch(fd, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO) >= 0)
+            {
+                alignas(inotify_event) char events[4096];
+                auto file_name = path.filename().string();
+                while (!stop.stop_requested())
+                {
+                    pollfd poll_fd{.fd = fd, .events = POLLIN, .revents = 0};
+                    if (::poll(&poll_fd, 1, static_cast<int>(m_poll_interval.count())) <= 0)
+                    {
+                        continue;
+                    }
+                    bool changed = false;
+                    for (ssize_t length; (length = ::read(fd, events, sizeof(events))) > 0;)
+                    {
+                        for (char* ptr = events; ptr < events + length;)
+                        {
+                            auto* event = reinterpret_cast<inotify_event*>(ptr);
+                            changed    |= event->len > 0 && file_name == event->name;
+                            ptr        += sizeof(inotify_event) + event->len;
+                        }
+                    }
+                    if (changed)
+                    {
+                        reload();
+                    }
+                }
+                ::close(fd);
+                return;
+            }
+            if (fd >= 0)
+            {
+                ::close(fd);
+            }
+#endif
+            std::error_code ec{};
+            auto last_write = std::filesystem::last_write_time(m_path, ec);
+            while (!stop.stop_requested())
+            {
+                std::this_thread::sleep_for(m_poll_interval);
+                auto write_time = std::filesystem::last_write_time(m_path, ec);
+                if (!ec && write_time != last_write)
+                {
+                    last_write = write_time;
+                    reload();
+                }
+            }
+        }
+
+    public:
+        ReloadableReader(const ReloadableReader&) = delete;
+        ReloadableReader& operator=(const ReloadableReader&) = delete;
+
+        // Builds the first snapshot (its error is returned as is) and starts watching the file.
+        // The poll interval also bounds how long destruction waits for the watcher thread.
+        static auto open(const std::string& file_path, str_v delimiter, Mode mode = Mode::Strict,
+                         std::chrono::milliseconds poll_interval = 200ms, ErrorCallback on_error = {}) -> std::expected<std::unique_ptr<ReloadableReader>, ReaderError>
+        {
+            std::unique_ptr<ReloadableReader> reloadable{new ReloadableReader{file_path, delimiter, mode, poll_interval, std::move(on_error)}};
+            if (auto loaded = reloadable->reload(); !loaded)
+            {
+                return std::unexpected(std::move(loaded.error()));
+            }
+            reloadable->m_watcher = std::jthread{[ptr = reloadable.get()](std::stop_token stop){ptr->watch(stop);}};
+            return reloadable;
+        }
+
+        // Rebuilds the reader now; on success publishes it as the new snapshot and clears last_error().
+        auto reload() -> std::expected<void, ReaderError>
+        {
+            std::lock_guard reloading{m_reload_mutex};
+            auto built = ParameterReader::build(m_path, m_delimiter, m_mode);
+            if (!built)
+            {
+                {
+                    std::lock_guard lock{m_error_mutex};
+                    m_last_error = built.error();
+                }
+                if (m_on_error)
+                {
+                    m_on_error(built.error());
+                }
+                return std::unexpected(std::move(built.error()));
+            }
+            m_snapshot.store(std::make_shared<const ParameterReader>(std::move(built.value())), std::memory_order_release);
+            m_generation.fetch_add(1, std::memory_order_release);
+            {
+                std::lock_guard lock{m_error_mutex};
+                m_last_error.reset();
+            }
+            return {};
+        }
+
+        // The current reader; it stays usable for as long as the returned pointer is held.
+        auto snapshot() const -> std::shared_ptr<const ParameterReader>
+        {
+            return m_snapshot.load(std::memory_order_acquire);
+        }
+        // Incremented after each successful (re)load.
+        auto generation() const -> uint64_t
+        {
+            return m_generation.load(std::memory_order_acquire);
+        }
+        auto last_error() const -> std::optional<ReaderError>
+        {
+            std::lock_guard lock{m_error_mutex};
+            return m_last_error;
+        }
+
+        // Per-thread handle for hot paths: get() costs one lock-free atomic load of the generation
+        // and only touches the shared snapshot when a reload happened since the previous call.
+        class LocalSnapshot
+        {
+            const ReloadableReader* m_source{};
+            uint64_t m_generation{};
+            std::shared_ptr<const ParameterReader> m_reader{};
+
+        public:
+            // The generation is read before the snapshot (reload() publishes them the other way round),
+            // so a concurrent reload can cost one extra refresh but never pairs an old reader with a new generation.
+            explicit LocalSnapshot(const ReloadableReader& source)
+                : m_source{&source}, m_generation{source.generation()}, m_reader{source.snapshot()}
+            {
+            }
+            auto get() -> const ParameterReader&
+            {
+                if (uint64_t generation = m_source->generation(); generation != m_generation)
+                {
+                    m_reader     = m_source->snapshot();
+                    m_generation = generation;
+                }
+                return *m_reader;
+            }
+        };
+        auto local_snapshot() const -> LocalSnapshot
+        {
+            return LocalSnapshot{*this};
+        }
+    };
+}
+#endif
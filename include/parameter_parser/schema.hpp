@@ -0,0 +1,217 @@
+#ifndef PARAMETER_SCHEMA_HPP
+#define PARAMETER_SCHEMA_HPP
+
+#include <algorithm>
+#include <array>
+#include <expected>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "parameter_parser/parse_traits.hpp"
+#include "parameter_parser/reader_error.hpp"
+#include "parameter_parser/sweep.hpp"
+#include "parameter_parser/utilities.hpp"
+
+namespace parameter_parser::reader
+{
+    using utilities::FixedString;
+
+    template<typename T>
+    struct member_pointer_traits;
+
+    template<typename S, typename M>
+    struct member_pointer_traits<M S::*>
+    {
+        using struct_type = S;
+        using member_type = M;
+    };
+
+    template<typename T>
+    constexpr bool is_std_vector_v = false;
+
+    template<typename T, typename A>
+    constexpr bool is_std_vector_v<std::vector<T, A>> = true;
+
+    template<typename T>
+    constexpr bool is_std_array_v = false;
+
+    template<typename T, size_t N>
+    constexpr bool is_std_array_v<std::array<T, N>> = true;
+
+    template<typename T>
+    concept NumType = std::is_integral_v<T> || std::is_floating_point_v<T>;
+
+    template<typename M>
+    concept BindableMember = utilities::Parsable<M> || std::is_same_v<M, std::string>
+                             || ((is_std_vector_v<M> || is_std_array_v<M>) && utilities::Parsable<typename M::value_type>);
+
+    // Parses a utilities::Parsable type, a std::array or std::vector of them (split on delim; vectors of numbers can also
+    // be written as a sweep) or a std::string. On failure returns the offending text: the bad value, or the bad vector
+    // tokens joined by ", ".
+    template<BindableMember M>
+    auto parse_as(str_v value, str_v delim) -> std::expected<M, std::string>
+    {
+        if constexpr (utilities::Parsable<M>)
+        {
+            return utilities::parse_value<M>(value).transform_error([](str_v bad){return std::string{bad};});
+        }
+        else if constexpr (is_std_array_v<M>)
+        {
+            return utilities::try_parse_array<typename M::value_type, std::tuple_size_v<M>>(value, delim).transform_error([](str_v bad){return std::string{bad};});
+        }
+        else if constexpr (is_std_vector_v<M> && utilities::Number<typename M::value_type>)
+        {
+            if (utilities::is_sweep(value, delim))
+            {
+                return utilities::try_parse_sweep<typename M::value_type>(value)
+                    .transform_error([](str_v bad){return std::string{bad};})
+                    .and_then([&](const auto& sweep) -> std::expected<M, std::string>
+                    {
+                        M values{};
+                        if (!utilities::append_sweep(sweep, values))
+                        {
+                            return std::unexpected(std::string{value});
+                        }
+                        return values;
+                    });
+            }
+            return utilities::try_parse_vec<typename M::value_type>(value, delim);
+        }
+        else if constexpr (is_std_vector_v<M>)
+        {
+            M values{};
+            bool valid = true;
+            utilities::for_each_token(value, delim, [&](str_v token, size_t)
+            {
+                auto parsed = utilities::parse_value<typename M::value_type>(token);
+                valid       = valid && parsed.has_value();
+                if (valid)
+                {
+                    values.push_back(std::move(parsed.value()));
+                }
+            });
+            if (!valid)
+            {
+                return std::unexpected(utilities::join_bad_values<typename M::value_type>(value, delim));
+            }
+            return values;
+        }
+        else
+        {
+            return std::string{value};
+        }
+    }
+
+    // One struct member bound to a key. Delim only matters for std::vector and std::array members.
+    template<FixedString Key, auto Member, FixedString Delim = ",">
+    struct Field
+    {
+        using traits      = member_pointer_traits<decltype(Member)>;
+        using struct_type = typename traits::struct_type;
+        using member_type = typename traits::member_type;
+        static_assert(BindableMember<member_type>, "Field members must be Parsable (numbers, bool, named enums, durations...), std::array or std::vector of them, or std::string");
+
+        static constexpr str_v key   = Key.view();
+        static constexpr str_v delim = Delim.view();
+
+        static auto assign(struct_type& target, str_v value) -> std::expected<void, std::string>
+        {
+            return parse_as<member_type>(value, delim).transform([&](member_type&& parsed){target.*Member = std::move(parsed);});
+        }
+    };
+
+    // Declares once which key fills which member of S, eg:
+    //     using SimSchema = Schema<SimParams, Field<"my_int", &SimParams::my_int>, Field<"ints", &SimParams::ints, "and">>;
+    // Keys are sorted at compile time, so binding visits each file entry once and finds its field by binary search.
+    template<typename S, typename... Fields>
+    struct Schema
+    {
+        using value_type = S;
+        static_assert(std::is_default_constructible_v<S>, "Schema structs must be default constructible");
+        static_assert((std::is_same_v<typename Fields::struct_type, S> && ...), "Every Field must point to a member of S");
+
+    private:
+        static constexpr size_t field_count = sizeof...(Fields);
+
+        static constexpr auto sorted_keys = []
+        {
+            std::array<std::pair<str_v, size_t>, field_count> keys{};
+            size_t i = 0;
+            ((keys[i] = std::pair{Fields::key, i}, i++), ...);
+            std::ranges::sort(keys);
+            return keys;
+        }();
+        static_assert(std::ranges::adjacent_find(sorted_keys, {}, &std::pair<str_v, size_t>::first) == sorted_keys.end(), "Schema keys must be unique");
+
+        static auto field_index(str_v key) -> size_t
+        {
+            auto it = std::ranges::lower_bound(sorted_keys, key, {}, &std::pair<str_v, size_t>::first);
+            return (it != sorted_keys.end() && it->first == key) ? it->second : field_count;
+        }
+        static auto assign(size_t index, S& target, str_v value) -> std::expected<void, std::string>
+        {
+            std::expected<void, std::string> result{};
+            [&]<size_t... I>(std::index_sequence<I...>)
+            {
+                ((index == I ? (result = std::tuple_element_t<I, std::tuple<Fields...>>::assign(target, value), true) : false) || ...);
+            }(std::index_sequence_for<Fields...>{});
+            return result;
+        }
+
+    public:
+        static auto contains(str_v key) -> bool
+        {
+            return field_index(key) != field_count;
+        }
+        // for_each_entry(visitor) must call visitor(key, value) for every entry of the source.
+        // Missing and malformed fields are all reported, in declaration order.
+        template<typename ForEachEntry>
+        static auto bind(ForEachEntry&& for_each_entry) -> std::expected<S, std::vector<ReaderError>>
+        {
+            S target{};
+            std::array<bool, field_count> found{};
+            std::array<std::string, field_count> bad_values{};
+            std::array<bool, field_count> malformed{};
+
+            for_each_entry([&](str_v key, str_v value)
+            {
+                size_t index = field_index(key);
+                if (index == field_count)
+                {
+                    return;
+                }
+                found[index] = true;
+                if (auto result = assign(index, target, value); !result)
+                {
+                    malformed[index]  = true;
+                    bad_values[index] = std::move(result.error());
+                }
+            });
+
+            std::vector<ReaderError> errors{};
+            std::array<str_v, field_count> keys{Fields::key...};
+            for (size_t i = 0; i < field_count; i++)
+            {
+                if (!found[i])
+                {
+                    errors.push_back(ReaderError{.args = std::string{keys[i]}, .from = ReaderError::From::try_bind, .kind = ReaderError::Kind::KeyError});
+                }
+                else if (malformed[i])
+                {
+                    std::string args = std::string{keys[i]} + ": " + bad_values[i];
+                    errors.push_back(ReaderError{.args = std::move(args), .from = ReaderError::From::try_bind, .kind = ReaderError::Kind::ParseError});
+                }
+            }
+            if (!errors.empty())
+            {
+                return std::unexpected(std::move(errors));
+            }
+            return target;
+        }
+    };
+}
+#endif
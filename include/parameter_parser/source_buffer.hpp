@@ -0,0 +1,252 @@
+#ifndef SOURCE_BUFFER_HPP
+#define SOURCE_BUFFER_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <istream>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+#include <string_view>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define PARAMETER_PARSER_HAS_MMAP 1
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace parameter_parser::reader
+{
+    // Immutable bytes of a parameter file: one owned block allocated from a memory_resource, a read-only memory mapping,
+    // or bytes borrowed from the caller.
+    // The reader stores std::string_view slices into it, so it never moves its bytes once created.
+    class SourceBuffer
+    {
+        static constexpr std::size_t alignment = alignof(std::max_align_t); // owned bytes can hold binary arrays, see ArrayFiles
+
+        std::pmr::memory_resource* m_resource{}; // set when the bytes are owned
+        std::size_t m_capacity{};
+        const char* m_data{};
+        std::size_t m_size{};
+        bool m_mapped{};
+
+        SourceBuffer(std::pmr::memory_resource* resource, char* owned, std::size_t capacity, std::size_t size)
+            : m_resource{resource}, m_capacity{capacity}, m_data{owned}, m_size{size}
+        {
+        }
+        SourceBuffer(const char* mapping, std::size_t size)
+            : m_data{mapping}, m_size{size}, m_mapped{true}
+        {
+        }
+        void release()
+        {
+#ifdef PARAMETER_PARSER_HAS_MMAP
+            if (m_mapped && m_data != nullptr)
+            {
+                ::munmap(const_cast<char*>(m_data), m_size);
+            }
+#endif
+            if (m_resource != nullptr && m_capacity > 0)
+            {
+                m_resource->deallocate(const_cast<char*>(m_data), m_capacity, alignment);
+            }
+            m_resource = nullptr;
+            m_capacity = 0;
+            m_data     = nullptr;
+            m_size   = 0;
+            m_mapped = false;
+        }
+        // Reads with read(destination, max_bytes) -> bytes read, 0 at the end, negative on error, into one block from
+        // resource that starts at capacity bytes and doubles when full.
+        template<typename Read>
+        static auto read_all(std::pmr::memory_resource* resource, std::size_t capacity, Read&& read) -> std::optional<SourceBuffer>
+        {
+            capacity = std::max<std::size_t>(capacity, 4096);
+            SourceBuffer buffer{resource, static_cast<char*>(resource->allocate(capacity, alignment)), capacity, 0};
+            while (true)
+            {
+                if (buffer.m_size == buffer.m_capacity)
+                {
+                    auto* bytes = static_cast<char*>(resource->allocate(2 * buffer.m_capacity, alignment));
+                    std::copy_n(buffer.m_data, buffer.m_size, bytes);
+                    buffer = SourceBuffer{resource, bytes, 2 * buffer.m_capacity, buffer.m_size};
+                }
+                auto* end = const_cast<char*>(buffer.m_data) + buffer.m_size;
+                auto count = read(end, buffer.m_capacity - buffer.m_size);
+                if (count < 0)
+                {
+                    return {};
+                }
+                if (count == 0)
+                {
+                    return buffer;
+                }
+                buffer.m_size += static_cast<std::size_t>(count);
+            }
+        }
+
+    public:
+        SourceBuffer() = default;
+        SourceBuffer(const SourceBuffer&) = delete;
+        SourceBuffer& operator=(const SourceBuffer&) = delete;
+        SourceBuffer(SourceBuffer&& other) noexcept
+            : m_resource{std::exchange(other.m_resource, nullptr)}, m_capacity{std::exchange(other.m_capacity, 0)}, m_data{std::exchange(other.m_data, nullptr)},
+              m_size{std::exchange(other.m_size, 0)}, m_mapped{std::exchange(other.m_mapped, false)}
+        {
+        }
+        SourceBuffer& operator=(SourceBuffer&& other) noexcept
+        {
+            if (this != &other)
+            {
+                release();
+                m_resource = std::exchange(other.m_resource, nullptr);
+                m_capacity = std::exchange(other.m_capacity, 0);
+                m_data     = std::exchange(other.m_data, nullptr);
+                m_size     = std::exchange(other.m_size, 0);
+                m_mapped   = std::exchange(other.m_mapped, false);
+            }
+            return *this;
+        }
+        ~SourceBuffer()
+        {
+            release();
+        }
+
+        // Reads the whole file with a single allocation from resource, which must outlive the buffer. A short read is a failure,
+        // not a truncated buffer.
+        static auto read_file(const char* file_path, std::pmr::memory_resource* resource = std::pmr::get_default_resource()) -> std::optional<SourceBuffer>
+        {
+            std::unique_ptr<std::FILE, decltype(&std::fclose)> file{std::fopen(file_path, "rb"), &std::fclose};
+            if (!file || std::fseek(file.get(), 0, SEEK_END) != 0)
+            {
+                return {};
+            }
+            long size = std::ftell(file.get());
+            if (size < 0 || std::fseek(file.get(), 0, SEEK_SET) != 0)
+            {
+                return {};
+            }
+            auto capacity = static_cast<std::size_t>(size);
+            if (capacity == 0)
+            {
+                return SourceBuffer{};
+            }
+            auto* bytes = static_cast<char*>(resource->allocate(capacity, alignment));
+            SourceBuffer buffer{resource, bytes, capacity, 0};
+            buffer.m_size = std::fread(bytes, 1, capacity, file.get());
+            if (buffer.m_size != capacity || std::ferror(file.get()) != 0) // an I/O error, or the file shrank since ftell
+            {
+                return {};
+            }
+            return buffer;
+        }
+
+        // Copies text into one owned allocation.
+        static auto copy_of(std::string_view text, std::pmr::memory_resource* resource = std::pmr::get_default_resource()) -> SourceBuffer
+        {
+            if (text.empty())
+            {
+                return SourceBuffer{};
+            }
+            auto* bytes = static_cast<char*>(resource->allocate(text.size(), alignment));
+            std::copy(text.begin(), text.end(), bytes);
+            return SourceBuffer{resource, bytes, text.size(), text.size()};
+        }
+
+        // Borrows text without copying it: text must outlive the buffer and every view into it.
+        static auto borrow(std::string_view text) -> SourceBuffer
+        {
+            SourceBuffer buffer{};
+            buffer.m_data = text.data();
+            buffer.m_size = text.size();
+            return buffer;
+        }
+
+        // Reads the stream to its end. Its size is unknown, so the buffer grows geometrically.
+        static auto read_stream(std::istream& stream, std::pmr::memory_resource* resource = std::pmr::get_default_resource()) -> std::optional<SourceBuffer>
+        {
+            return read_all(resource, 0, [&](char* destination, std::size_t max_bytes) -> std::streamsize
+            {
+                stream.read(destination, static_cast<std::streamsize>(max_bytes));
+                return stream.bad() ? -1 : stream.gcount();
+            });
+        }
+
+#ifdef PARAMETER_PARSER_HAS_MMAP
+        // Reads the descriptor to its end (eg: a pipe or stdin) without closing it; a regular file is read with a single allocation.
+        static auto read_fd(int fd, std::pmr::memory_resource* resource = std::pmr::get_default_resource()) -> std::optional<SourceBuffer>
+        {
+            struct stat info{};
+            std::size_t capacity = (::fstat(fd, &info) == 0 && S_ISREG(info.st_mode)) ? static_cast<std::size_t>(info.st_size) + 1 : 0;
+            return read_all(resource, capacity, [&](char* destination, std::size_t max_bytes) -> ssize_t
+            {
+                ssize_t count{};
+                while ((count = ::read(fd, destination, max_bytes)) < 0 && errno == EINTR)
+                {
+                }
+                return count;
+            });
+        }
+        // Maps a regular file read-only without closing fd; other descriptors are read with read_fd.
+        static auto map_fd(int fd, std::pmr::memory_resource* resource = std::pmr::get_default_resource()) -> std::optional<SourceBuffer>
+        {
+            struct stat info{};
+            if (::fstat(fd, &info) != 0)
+            {
+                return {};
+            }
+            if (!S_ISREG(info.st_mode))
+            {
+                return read_fd(fd, resource);
+            }
+            auto size = static_cast<std::size_t>(info.st_size);
+            if (size == 0) // mmap rejects empty lengths
+            {
+                return SourceBuffer{};
+            }
+            void* mapping = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapping == MAP_FAILED)
+            {
+                return {};
+            }
+            return SourceBuffer{static_cast<const char*>(mapping), size};
+        }
+#endif
+
+        // Maps the file read-only; falls back to read_file(file_path, resource) where mmap is unavailable.
+        static auto map_file(const char* file_path, [[maybe_unused]] std::pmr::memory_resource* resource = std::pmr::get_default_resource()) -> std::optional<SourceBuffer>
+        {
+#ifdef PARAMETER_PARSER_HAS_MMAP
+            int fd = ::open(file_path, O_RDONLY);
+            if (fd < 0)
+            {
+                return {};
+            }
+            auto buffer = map_fd(fd, resource);
+            ::close(fd);
+            return buffer;
+#else
+            return read_file(file_path, resource);
+#endif
+        }
+
+        auto view() const -> std::string_view
+        {
+            return {m_data, m_size};
+        }
+        auto size() const -> std::size_t
+        {
+            return m_size;
+        }
+        auto is_mapped() const -> bool
+        {
+            return m_mapped;
+        }
+    };
+}
+#endif
@@ -0,0 +1,327 @@
+#ifndef PARAMETER_SWEEP_HPP
+#define PARAMETER_SWEEP_HPP
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cmath>
+#include <compare>
+#include <cstddef>
+#include <expected>
+#include <iterator>
+#include <new>
+#include <ranges>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include "parameter_parser/utilities.hpp"
+
+namespace parameter_parser::utilities
+{
+    // Arithmetic sequence computed on demand: element i is start + i * step, and the last element of a linspace is exactly stop.
+    // A random-access view, so a 10^6 point sweep costs a few numbers until it is materialized with to_vector().
+    template<typename T>
+        requires std::is_integral_v<T> || std::is_floating_point_v<T>
+    class Sweep : public std::ranges::view_interface<Sweep<T>>
+    {
+        T m_start{};
+        T m_step{};
+        T m_last{};
+        size_t m_size{};
+
+    public:
+        // Holds the sweep's values rather than a pointer to it, so that it outlives the Sweep (see enable_borrowed_range below).
+        class iterator
+        {
+            T m_start{};
+            T m_step{};
+            T m_last{};
+            std::ptrdiff_t m_last_index{};
+            std::ptrdiff_t m_index{};
+
+        public:
+            using iterator_concept = std::random_access_iterator_tag;
+            using value_type       = T;
+            using difference_type  = std::ptrdiff_t;
+
+            iterator() = default;
+            iterator(const Sweep& sweep, std::ptrdiff_t index)
+                : m_start{sweep.m_start}, m_step{sweep.m_step}, m_last{sweep.m_last}, m_last_index{static_cast<std::ptrdiff_t>(sweep.m_size) - 1}, m_index{index}
+            {
+            }
+            auto operator*() const -> T
+            {
+                return (m_index == m_last_index) ? m_last : element(m_start, m_step, static_cast<size_t>(m_index));
+            }
+            auto operator[](difference_type n) const -> T
+            {
+                return *(*this + n);
+            }
+            auto operator++() -> iterator&
+            {
+                ++m_index;
+                return *this;
+            }
+            auto operator++(int) -> iterator
+            {
+                iterator previous = *this;
+                ++m_index;
+                return previous;
+            }
+            auto operator--() -> iterator&
+            {
+                --m_index;
+                return *this;
+            }
+            auto operator--(int) -> iterator
+            {
+                iterator previous = *this;
+                --m_index;
+                return previous;
+            }
+            auto operator+=(difference_type n) -> iterator&
+            {
+                m_index += n;
+                return *this;
+            }
+            auto operator-=(difference_type n) -> iterator&
+            {
+                m_index -= n;
+                return *this;
+            }
+            friend auto operator+(iterator it, difference_type n) -> iterator
+            {
+                return it += n;
+            }
+            friend auto operator+(difference_type n, iterator it) -> iterator
+            {
+                return it += n;
+            }
+            friend auto operator-(iterator it, difference_type n) -> iterator
+            {
+                return it -= n;
+            }
+            friend auto operator-(const iterator& a, const iterator& b) -> difference_type
+            {
+                return a.m_index - b.m_index;
+            }
+            friend auto operator==(const iterator& a, const iterator& b) -> bool
+            {
+                return a.m_index == b.m_index;
+            }
+            friend auto operator<=>(const iterator& a, const iterator& b) -> std::strong_ordering
+            {
+                return a.m_index <=> b.m_index;
+            }
+        };
+
+        Sweep() = default;
+        Sweep(T start, T step, T last, size_t size)
+            : m_start{start}, m_step{step}, m_last{last}, m_size{size}
+        {
+        }
+
+        static auto element(T start, T step, size_t i) -> T
+        {
+            if constexpr (std::is_integral_v<T>) // unsigned arithmetic: a descending sweep must not overflow the signed product
+            {
+                using U = std::make_unsigned_t<T>;
+                return static_cast<T>(static_cast<U>(start) + static_cast<U>(i) * static_cast<U>(step));
+            }
+            else
+            {
+                return start + static_cast<T>(i) * step;
+            }
+        }
+        auto operator[](size_t i) const -> T
+        {
+            return (i + 1 == m_size) ? m_last : element(m_start, m_step, i);
+        }
+        auto size() const -> size_t
+        {
+            return m_size;
+        }
+        auto begin() const -> iterator
+        {
+            return iterator{*this, 0};
+        }
+        auto end() const -> iterator
+        {
+            return iterator{*this, static_cast<std::ptrdiff_t>(m_size)};
+        }
+        auto to_vector() const -> std::vector<T>
+        {
+            std::vector<T> values(m_size);
+            for (size_t i = 0; i < m_size; i++)
+            {
+                values[i] = (*this)[i];
+            }
+            return values;
+        }
+    };
+
+    // Longest lazy sweep: beyond it, element indices stop being exact in a double. A sweep this long is only usable as a view,
+    // materializing it is capped by max_materialized_sweep_size.
+    inline constexpr size_t max_sweep_size = 1'000'000'000'000'000;
+    // Longest sweep try_parse_vector and struct binding turn into a vector (2^28 elements, 2 GiB of doubles).
+    inline constexpr size_t max_materialized_sweep_size = size_t{1} << 28;
+
+    // Appends every element of sweep to values. Returns false, leaving values unchanged, when the sweep is longer than
+    // max_materialized_sweep_size or its storage cannot be allocated, so that callers report a ParseError instead of throwing.
+    template<typename T, typename Vector>
+    auto append_sweep(const Sweep<T>& sweep, Vector& values) -> bool
+    {
+        if (sweep.size() > max_materialized_sweep_size || sweep.size() > values.max_size() - values.size())
+        {
+            return false;
+        }
+        try
+        {
+            values.reserve(values.size() + sweep.size());
+        }
+        catch (const std::bad_alloc&)
+        {
+            return false;
+        }
+        std::ranges::copy(sweep, std::back_inserter(values));
+        return true;
+    }
+
+    // True if value is written as a sweep rather than as a list split on delim: linspace(a, b, n), or start:step:stop
+    // (start:stop steps by 1) made of 2 or 3 complete numbers, when neither delim nor value contain the other's separator.
+    // Any other value, eg: "12:30, 13:45" split on ",", stays a plain list.
+    inline auto is_sweep(str_v value, str_v delim) -> bool
+    {
+        value = trim(value);
+        if (value.starts_with("linspace(") && value.ends_with(')'))
+        {
+            return true;
+        }
+        if (delim.find(':') != str_v::npos || value.find(':') == str_v::npos || (!delim.empty() && value.find(delim) != str_v::npos))
+        {
+            return false;
+        }
+        size_t count = 0;
+        bool numbers = true;
+        for_each_token(value, ":"sv, [&](str_v field, size_t)
+        {
+            double number{};
+            auto [end, ec] = std::from_chars(field.data(), field.data() + field.length(), number);
+            numbers        = numbers && !field.empty() && ec == std::errc{} && end == field.data() + field.length();
+            count++;
+        });
+        return numbers && (count == 2 || count == 3);
+    }
+
+    // Parses "start:step:stop", "start:stop" (both inclusive of stop when it is reached) or "linspace(a, b, n)".
+    // On failure returns the offending part: a bad number, or the whole value when its form is wrong
+    // (zero step, integer linspace with uneven spacing, ...). A step going away from stop gives an empty sweep.
+    template<typename T>
+    auto try_parse_sweep(str_v value) -> expected<Sweep<T>, str_v>
+        requires std::is_integral_v<T> || std::is_floating_point_v<T>
+    {
+        value = trim(value);
+        std::array<str_v, 3> fields{};
+        size_t count   = 0;
+        bool linspace  = value.starts_with("linspace(") && value.ends_with(')');
+        str_v args     = linspace ? value.substr(9, value.length() - 10) : value;
+        for_each_token(args, linspace ? ","sv : ":"sv, [&](str_v token, size_t)
+        {
+            count++;
+            if (count <= fields.size())
+            {
+                fields[count - 1] = token;
+            }
+        });
+        if (count != 3 && (linspace || count != 2))
+        {
+            return std::unexpected(value);
+        }
+
+        str_v stop_field = linspace ? fields[1] : fields[count - 1];
+        auto start       = parse_num_handled<T>(fields[0]);
+        auto stop        = parse_num_handled<T>(stop_field);
+        if (!start || !stop)
+        {
+            return std::unexpected(!start ? fields[0] : stop_field);
+        }
+        if (linspace)
+        {
+            auto n = parse_num_handled<size_t>(fields[2]);
+            if (!n)
+            {
+                return std::unexpected(fields[2]);
+            }
+            if (n.value() > max_sweep_size)
+            {
+                return std::unexpected(fields[2]);
+            }
+            if (n.value() <= 1)
+            {
+                return Sweep<T>{start.value(), T{}, start.value(), n.value()};
+            }
+            long double step = (static_cast<long double>(stop.value()) - static_cast<long double>(start.value())) / static_cast<long double>(n.value() - 1);
+            if constexpr (std::is_integral_v<T>)
+            {
+                if (step != std::trunc(step))
+                {
+                    return std::unexpected(value);
+                }
+                // a negative step wraps around for unsigned T, which element() undoes
+                return Sweep<T>{start.value(), static_cast<T>(static_cast<long long>(step)), stop.value(), n.value()};
+            }
+            else
+            {
+                return Sweep<T>{start.value(), static_cast<T>(step), stop.value(), n.value()};
+            }
+        }
+
+        auto step = (count == 3) ? parse_num_handled<T>(fields[1]) : expected<T, str_v>{T{1}};
+        if (!step)
+        {
+            return std::unexpected(step.error());
+        }
+        T first = start.value();
+        T delta = step.value();
+        if (delta == T{})
+        {
+            return std::unexpected(value);
+        }
+        if ((delta > T{}) ? stop.value() < first : stop.value() > first)
+        {
+            return Sweep<T>{};
+        }
+        size_t size = 0;
+        if constexpr (std::is_integral_v<T>)
+        {
+            using U  = std::make_unsigned_t<T>;
+            U distance = (delta > T{}) ? static_cast<U>(static_cast<U>(stop.value()) - static_cast<U>(first)) : static_cast<U>(static_cast<U>(first) - static_cast<U>(stop.value()));
+            U stride   = (delta > T{}) ? static_cast<U>(delta) : static_cast<U>(U{0} - static_cast<U>(delta));
+            if (distance / stride >= max_sweep_size)
+            {
+                return std::unexpected(value);
+            }
+            size       = static_cast<size_t>(distance / stride) + 1;
+        }
+        else
+        {
+            // tolerate the rounding of eg: (1.9 - 1.0) / 0.1 so that a reachable stop is included
+            double steps = std::floor(static_cast<double>((stop.value() - first) / delta) + 1e-9);
+            if (!std::isfinite(steps) || steps >= static_cast<double>(max_sweep_size))
+            {
+                return std::unexpected(value);
+            }
+            size = static_cast<size_t>(steps) + 1;
+        }
+        return Sweep<T>{first, delta, Sweep<T>::element(first, delta, size - 1), size};
+    }
+}
+
+// Iterators do not point into the Sweep, so they stay valid after it is destroyed, eg: from a returned views::take(sweep, n).
+namespace std::ranges
+{
+    template<typename T>
+    inline constexpr bool enable_borrowed_range<parameter_parser::utilities::Sweep<T>> = true;
+}
+#endif
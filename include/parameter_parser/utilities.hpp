@@ -4,10 +4,18 @@
 #include <iostream>
 #include <ranges>
 #include <vector>
+#include <span>
+#include <string>
 #include <string_view>
 #include <expected>
 #include <optional>
 #include <charconv>
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <cstdint>
+#include <memory_resource>
 
 using std::tuple;
 using std::optional;
@@ -17,7 +25,22 @@ using namespace std::string_view_literals;
  
 namespace parameter_parser::utilities
 {
-    auto split_once(str_v input, str_v delim) -> optional<tuple<str_v,str_v>>
+    // String literal usable as a template argument, eg: Field<"my_int", &Params::my_int>
+    template <size_t N>
+    struct FixedString
+    {
+        char data[N]{};
+        constexpr FixedString(const char (&str)[N])
+        {
+            std::copy_n(str, N, data);
+        }
+        constexpr auto view() const -> str_v
+        {
+            return str_v{data, N - 1};
+        }
+    };
+
+    constexpr auto split_once(str_v input, str_v delim) -> optional<tuple<str_v,str_v>>
     {
         size_t n = input.find(delim);
         if (n == str_v::npos)
@@ -29,7 +52,7 @@ namespace parameter_parser::utilities
         return tuple{token1, token2};
     }
 
-    auto trim(str_v input) -> str_v
+    constexpr auto trim(str_v input) -> str_v
     {
         str_v s = input;
         if (size_t front_space = std::min(s.find_first_not_of(' '), s.length())) // if the str_v is nothing but blank we remove everything
@@ -43,10 +66,150 @@ namespace parameter_parser::utilities
         return s;
     }
 
+    // An INI-style "[section]" line: a bracketed line without delimiter. Returns the trimmed section name.
+    constexpr auto section_header(str_v line, str_v delimiter) -> optional<str_v>
+    {
+        line = trim(line);
+        if (line.length() < 2 || line.front() != '[' || line.back() != ']' || line.find(delimiter) != str_v::npos)
+        {
+            return {};
+        }
+        return trim(line.substr(1, line.length() - 2));
+    }
+
+    // Not constexpr: reaching it stops a constant evaluation, with its name in the compiler's message.
+    inline auto float_not_exact_at_compile_time() -> void
+    {
+    }
+
+    // std::from_chars as parse_num_handled uses it, during constant evaluation: the longest leading number is parsed and
+    // an out-of-range value leaves T{}. A float is computed with one exact multiplication or division of its significant
+    // digits by a power of ten (at most 2^53, resp. 2^24 for float, and 10^22, resp. 10^10), so it rounds exactly like
+    // from_chars. Other floats, eg: 1e-30 or 0.1234567890123456789, stop the constant evaluation.
+    template <typename T>
+    constexpr auto parse_num_constexpr(str_v view) -> expected<T, str_v>
+        requires std::is_integral_v<T> || std::is_floating_point_v<T>
+    {
+        auto digit_at  = [&](size_t pos){return (pos < view.length() && view[pos] >= '0' && view[pos] <= '9') ? view[pos] - '0' : -1;};
+        bool negative  = (std::is_signed_v<T> || std::is_floating_point_v<T>) && view.starts_with('-');
+        size_t pos     = negative ? 1 : 0;
+        if constexpr (std::is_integral_v<T>)
+        {
+            constexpr uint64_t max_value = std::numeric_limits<T>::max();
+            uint64_t magnitude = 0;
+            bool out_of_range  = false;
+            size_t first       = pos;
+            for (int digit = digit_at(pos); digit >= 0; digit = digit_at(++pos))
+            {
+                out_of_range |= magnitude > (std::numeric_limits<uint64_t>::max() - static_cast<uint64_t>(digit)) / 10;
+                magnitude     = magnitude * 10 + static_cast<uint64_t>(digit);
+            }
+            if (pos == first)
+            {
+                return std::unexpected(view);
+            }
+            if (out_of_range || magnitude > max_value + (negative ? 1 : 0))
+            {
+                return T{};
+            }
+            return negative ? static_cast<T>(0 - magnitude) : static_cast<T>(magnitude);
+        }
+        else
+        {
+            constexpr bool double_like   = std::numeric_limits<T>::digits >= 53;
+            constexpr uint64_t max_exact = uint64_t{1} << (double_like ? 53 : 24);
+            constexpr int max_power      = double_like ? 22 : 10;
+
+            auto starts_with_word = [&](str_v word)
+            {
+                return view.length() - pos >= word.length() && std::ranges::equal(view.substr(pos, word.length()), word, {}, [](char c){return (c >= 'A' && c <= 'Z') ? c - 'A' + 'a' : c;});
+            };
+            if (starts_with_word("inf"))
+            {
+                return negative ? -std::numeric_limits<T>::infinity() : std::numeric_limits<T>::infinity();
+            }
+            if (starts_with_word("nan"))
+            {
+                return negative ? -std::numeric_limits<T>::quiet_NaN() : std::numeric_limits<T>::quiet_NaN();
+            }
+            uint64_t mantissa = 0;
+            int exponent      = 0;
+            int significant   = 0;
+            bool any_digit    = false;
+            bool exact        = true;
+            auto push_digit   = [&](int digit, bool fraction)
+            {
+                any_digit = true;
+                if (significant < 19)
+                {
+                    mantissa     = mantissa * 10 + static_cast<uint64_t>(digit);
+                    significant += (mantissa != 0) ? 1 : 0;
+                    exponent    -= fraction ? 1 : 0;
+                }
+                else
+                {
+                    exact     = exact && digit == 0;
+                    exponent += fraction ? 0 : 1;
+                }
+            };
+            for (int digit = digit_at(pos); digit >= 0; digit = digit_at(++pos))
+            {
+                push_digit(digit, false);
+            }
+            if (pos < view.length() && view[pos] == '.')
+            {
+                for (int digit = digit_at(++pos); digit >= 0; digit = digit_at(++pos))
+                {
+                    push_digit(digit, true);
+                }
+            }
+            if (!any_digit)
+            {
+                return std::unexpected(view);
+            }
+            if (pos < view.length() && (view[pos] == 'e' || view[pos] == 'E'))
+            {
+                size_t sign      = pos + 1;
+                bool exp_negative = sign < view.length() && view[sign] == '-';
+                size_t first      = (sign < view.length() && (view[sign] == '-' || view[sign] == '+')) ? sign + 1 : sign;
+                int power         = 0;
+                for (int digit = digit_at(first); digit >= 0 && power < 100000; digit = digit_at(++first))
+                {
+                    power = power * 10 + digit;
+                }
+                exponent += (digit_at(sign) >= 0 || first > sign + 1) ? (exp_negative ? -power : power) : 0;
+            }
+            if (mantissa == 0)
+            {
+                return negative ? -T{} : T{};
+            }
+            while (exponent > max_power && mantissa * 10 <= max_exact)
+            {
+                mantissa *= 10;
+                exponent--;
+            }
+            if (!exact || mantissa > max_exact || exponent > max_power || exponent < -max_power)
+            {
+                float_not_exact_at_compile_time();
+            }
+            T scale = 1;
+            for (int i = 0; i < (exponent < 0 ? -exponent : exponent); i++)
+            {
+                scale *= 10;
+            }
+            T value = (exponent < 0) ? static_cast<T>(mantissa) / scale : static_cast<T>(mantissa) * scale;
+            return negative ? -value : value;
+        }
+    }
+
     template <typename T>
-    auto parse_num_handled(str_v view) -> expected<T, str_v> 
+    constexpr auto parse_num_handled(str_v view) -> expected<T, str_v> 
         requires std::is_integral_v<T> || std::is_floating_point_v<T>
     {
+        if consteval
+        {
+            return parse_num_constexpr<T>(view);
+        }
         const char* first = view.data();
         const char* last  = view.data() + view.length();
         T value{};
@@ -59,26 +222,185 @@ namespace parameter_parser::utilities
     }
 
 
+    struct TokenError
+    {
+        str_v token{};
+        size_t offset{}; // position of the (trimmed) token in the parsed line
+    };
+
+    // Number of tokens for_each_token will visit: an empty line has none.
+    constexpr auto count_tokens(str_v line, str_v delim) -> size_t
+    {
+        if (line.empty() || delim.empty())
+        {
+            return line.empty() ? 0 : 1;
+        }
+        size_t count = 1;
+        for (size_t n = line.find(delim); n != str_v::npos; n = line.find(delim, n + delim.length()))
+        {
+            count++;
+        }
+        return count;
+    }
+
+    // Visits every trimmed token of line split on delim in a single left-to-right scan.
+    // str_v::find goes through memchr, which the C library vectorizes.
+    template <typename F>
+    constexpr auto for_each_token(str_v line, str_v delim, F&& visit) -> void
+    {
+        if (line.empty())
+        {
+            return;
+        }
+        size_t start = 0;
+        while (true)
+        {
+            size_t n     = delim.empty() ? str_v::npos : line.find(delim, start);
+            size_t end   = (n == str_v::npos) ? line.length() : n;
+            str_v token  = trim(line.substr(start, end - start));
+            visit(token, static_cast<size_t>(token.data() - line.data()));
+            if (n == str_v::npos)
+            {
+                return;
+            }
+            start = n + delim.length();
+        }
+    }
+
+    // Appends the parsed tokens to out in a single pass over line: a caller that knows the count reserves out itself.
+    // On error out is left unchanged.
+    // out may use any allocator, eg: a std::pmr::vector backed by an arena.
+    template <typename T, typename Alloc>
+    auto try_parse_vec_into(str_v line, str_v delim, std::vector<T, Alloc>& out) -> expected<size_t, std::vector<TokenError>>
+        requires std::is_integral_v<T> || std::is_floating_point_v<T>
+    {
+        const size_t old_size = out.size();
+        std::vector<TokenError> errors{};
+        for_each_token(line, delim, [&](str_v token, size_t offset)
+        {
+            auto result = parse_num_handled<T>(token);
+            if (!result)
+            {
+                errors.push_back(TokenError{.token = token, .offset = offset});
+                return;
+            }
+            out.push_back(result.value());
+        });
+        if (!errors.empty())
+        {
+            out.resize(old_size);
+            return std::unexpected(std::move(errors));
+        }
+        return out.size() - old_size;
+    }
+
+    // Parses into caller-owned storage and returns the number of values written.
+    // Tokens that do not fit in out are reported as errors, like malformed ones.
     template <typename T>
-    auto try_parse_vec(str_v line, str_v delim) -> expected<std::vector<T>, std::string> 
+    auto try_parse_vec_into(str_v line, str_v delim, std::span<T> out) -> expected<size_t, std::vector<TokenError>>
+        requires std::is_integral_v<T> || std::is_floating_point_v<T>
+    {
+        std::vector<TokenError> errors{};
+        size_t written = 0;
+        for_each_token(line, delim, [&](str_v token, size_t offset)
+        {
+            auto result = parse_num_handled<T>(token);
+            if (!result || written == out.size())
+            {
+                errors.push_back(TokenError{.token = token, .offset = offset});
+                return;
+            }
+            out[written++] = result.value();
+        });
+        if (!errors.empty())
+        {
+            return std::unexpected(std::move(errors));
+        }
+        return written;
+    }
+
+    // Writes the parsed tokens through out and returns the iterator past the last value; allocates only to report errors.
+    // On error out may already have received the values preceding the first bad token.
+    template <typename T, std::output_iterator<const T&> Out>
+    auto try_parse_vec_into(str_v line, str_v delim, Out out) -> expected<Out, std::vector<TokenError>>
+        requires std::is_integral_v<T> || std::is_floating_point_v<T>
+    {
+        std::vector<TokenError> errors{};
+        for_each_token(line, delim, [&](str_v token, size_t offset)
+        {
+            auto result = parse_num_handled<T>(token);
+            if (!result)
+            {
+                errors.push_back(TokenError{.token = token, .offset = offset});
+                return;
+            }
+            if (errors.empty())
+            {
+                *out = result.value();
+                ++out;
+            }
+        });
+        if (!errors.empty())
+        {
+            return std::unexpected(std::move(errors));
+        }
+        return out;
+    }
+
+    inline auto join_tokens(const std::vector<TokenError>& errors) -> std::string
+    {
+        std::string joined{};
+        for (const auto& error : errors)
+        {
+            if (!joined.empty())
+            {
+                joined += ", "sv;
+            }
+            joined += error.token;
+        }
+        return joined;
+    }
+
+    // The tokens of line that do not parse as T, joined like try_parse_vec reports them.
+    template <typename T>
+    auto join_bad_tokens(str_v line, str_v delim) -> std::string
         requires std::is_integral_v<T> || std::is_floating_point_v<T>
     {
-        auto to_str_v  = [](auto token){return str_v{token};};
-        auto try_parse = [](auto sv){return parse_num_handled<T>(sv);};
-        auto has_error = [](const auto& res){return !res.has_value();};
-        auto get_error = [](const auto& res){return res.error();};
-        auto get_value = [](const auto& res){return res.value();};
+        std::string joined{};
+        for_each_token(line, delim, [&](str_v token, size_t)
+        {
+            if (!parse_num_handled<T>(token))
+            {
+                joined += joined.empty() ? ""sv : ", "sv;
+                joined += token;
+            }
+        });
+        return joined;
+    }
 
-        auto tokens        = line | std::views::split(delim) | std::views::transform(to_str_v);
-        auto expected_nums = tokens | std::views::transform(trim) | std::views::transform(try_parse); 
-        auto parse_errors  = expected_nums | std::views::filter(has_error) | std::views::transform(get_error); 
-        
-        if(!std::ranges::empty(parse_errors))
+    template <typename T>
+    auto try_parse_vec(str_v line, str_v delim) -> expected<std::vector<T>, std::string> 
+        requires std::is_integral_v<T> || std::is_floating_point_v<T>
+    {
+        std::vector<T> nums{};
+        auto result = try_parse_vec_into<T>(line, delim, nums);
+        if (!result)
+        {
+            return std::unexpected(join_tokens(result.error()));
+        }
+        return nums;
+    }
+    // Same as above, with the values allocated from resource.
+    template <typename T>
+    auto try_parse_vec(str_v line, str_v delim, std::pmr::memory_resource* resource) -> expected<std::pmr::vector<T>, std::string>
+        requires std::is_integral_v<T> || std::is_floating_point_v<T>
+    {
+        std::pmr::vector<T> nums{resource};
+        auto result = try_parse_vec_into<T>(line, delim, nums);
+        if (!result)
         {
-            auto errors_str = parse_errors | std::views::join_with(", "sv) | std::ranges::to<std::string>();
-            return std::unexpected(errors_str);
+            return std::unexpected(join_tokens(result.error()));
         }
-        auto nums = expected_nums | std::views::transform(get_value)| std::ranges::to<std::vector>();
         return nums;
     }
 }
@@ -0,0 +1,248 @@
+#ifndef PARAMETER_WRITER_HPP
+#define PARAMETER_WRITER_HPP
+
+#include <algorithm>
+#include <charconv>
+#include <cstddef>
+#include <cstdio>
+#include <expected>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "parameter_parser/matrix.hpp"
+#include "parameter_parser/reader_error.hpp"
+#include "parameter_parser/utilities.hpp"
+
+using str_v = std::string_view;
+
+namespace parameter_parser::writer
+{
+    template<typename T>
+    concept WritableNum = (std::is_integral_v<T> || std::is_floating_point_v<T>) && !std::is_same_v<T, bool>;
+
+    // Writes "key <delimiter> value" lines that ParameterReader::build reads back, formatting numbers with std::to_chars
+    // (floats in their shortest form, so they parse back to the same value) into one reusable buffer.
+    // A file is only written when the buffer is full or on flush(), with a single unbuffered fwrite.
+    // Errors are sticky: the write_* calls can be chained and the first error is returned by flush() or close().
+    // Entries that would not read back as written are skipped with a ParseError: keys holding the delimiter or a newline,
+    // and keys or string values with a newline or leading/trailing spaces.
+    class ParameterWriter
+    {
+        static constexpr size_t max_num_chars = 64; // longest std::to_chars output, with room to spare
+
+        std::unique_ptr<std::FILE, decltype(&std::fclose)> m_file{nullptr, &std::fclose}; // null: the output stays in the buffer
+        std::string m_path{};
+        std::string m_delimiter{};
+        std::vector<char> m_buffer{};
+        size_t m_used{};
+        std::optional<ReaderError> m_error{};
+
+        ParameterWriter(std::FILE* file, std::string path, str_v delimiter, size_t buffer_size)
+            : m_file{file, &std::fclose}, m_path{std::move(path)}, m_delimiter{std::string{" "} + std::string{delimiter} + " "}, m_buffer(std::max<size_t>(buffer_size, max_num_chars))
+        {
+        }
+
+        // Makes room for count more bytes: flushes a file writer, grows an in-memory one (or an entry larger than the buffer).
+        auto reserve(size_t count) -> char*
+        {
+            if (m_used + count > m_buffer.size() && m_file)
+            {
+                write_out();
+            }
+            if (m_used + count > m_buffer.size())
+            {
+                m_buffer.resize(std::max(2 * m_buffer.size(), m_used + count));
+            }
+            return m_buffer.data() + m_used;
+        }
+        auto write_out() -> void
+        {
+            if (m_used > 0 && !m_error.has_value() && std::fwrite(m_buffer.data(), 1, m_used, m_file.get()) != m_used)
+            {
+                m_error = ReaderError{.args = m_path, .from = ReaderError::From::write, .kind = ReaderError::Kind::FileError};
+            }
+            m_used = 0;
+        }
+        auto append(str_v text) -> void
+        {
+            std::ranges::copy(text, reserve(text.size()));
+            m_used += text.size();
+        }
+        template<WritableNum T>
+        auto append_num(T value) -> void
+        {
+            char* first = reserve(max_num_chars);
+            m_used      = static_cast<size_t>(std::to_chars(first, first + max_num_chars, value).ptr - m_buffer.data());
+        }
+        // Records a ParseError for text, the part of an entry that would not read back as written.
+        auto reject(str_v text) -> bool
+        {
+            if (!m_error.has_value())
+            {
+                m_error = ReaderError{.args = std::string{text}, .from = ReaderError::From::write, .kind = ReaderError::Kind::ParseError};
+            }
+            return false;
+        }
+        static auto round_trips(str_v text) -> bool
+        {
+            return text.find('\n') == str_v::npos && utilities::trim(text).length() == text.length();
+        }
+        // Starts the entry of key, or returns false when key cannot be read back.
+        auto begin_entry(str_v key) -> bool
+        {
+            str_v delimiter = str_v{m_delimiter}.substr(1, m_delimiter.length() - 2);
+            if (!round_trips(key) || key.find(delimiter) != str_v::npos)
+            {
+                return reject(key);
+            }
+            append(key);
+            append(m_delimiter);
+            return true;
+        }
+
+    public:
+        // Writes to file_path, truncating it. The buffer is written out whenever buffer_size bytes are pending.
+        static auto open(const std::string& file_path, str_v delimiter, size_t buffer_size = size_t{1} << 20) -> std::expected<ParameterWriter, ReaderError>
+        {
+            std::FILE* file = std::fopen(file_path.c_str(), "wb");
+            if (file == nullptr)
+            {
+                ReaderError error{.args = file_path, .from = ReaderError::From::write, .kind = ReaderError::Kind::FileError};
+                return std::unexpected(error);
+            }
+            std::setvbuf(file, nullptr, _IONBF, 0); // the writer is the buffer: one write per flush
+            return ParameterWriter{file, file_path, delimiter, buffer_size};
+        }
+        // Keeps the output in memory, see view(); eg: to hand it to ParameterReader::build_from_buffer.
+        explicit ParameterWriter(str_v delimiter, size_t buffer_size = size_t{1} << 16)
+            : ParameterWriter{nullptr, {}, delimiter, buffer_size}
+        {
+        }
+        ParameterWriter(ParameterWriter&& other) noexcept
+            : m_file{std::move(other.m_file)}, m_path{std::move(other.m_path)}, m_delimiter{std::move(other.m_delimiter)},
+              m_buffer{std::move(other.m_buffer)}, m_used{std::exchange(other.m_used, 0)}, m_error{std::move(other.m_error)}
+        {
+        }
+        ParameterWriter& operator=(ParameterWriter&&) = delete; // would drop the pending bytes of this writer
+        ~ParameterWriter()
+        {
+            if (m_file)
+            {
+                write_out();
+            }
+        }
+
+        template<WritableNum T>
+        auto write_num(str_v key, T value) -> ParameterWriter&
+        {
+            if (!begin_entry(key))
+            {
+                return *this;
+            }
+            append_num(value);
+            append("\n");
+            return *this;
+        }
+        template<WritableNum T>
+        auto write_vector(str_v key, std::span<const T> values, str_v delim) -> ParameterWriter&
+        {
+            if (!begin_entry(key))
+            {
+                return *this;
+            }
+            for (size_t i = 0; i < values.size(); i++)
+            {
+                if (i > 0)
+                {
+                    append(delim);
+                }
+                append_num(values[i]);
+            }
+            append("\n");
+            return *this;
+        }
+        template<WritableNum T>
+        auto write_vector(str_v key, const std::vector<T>& values, str_v delim) -> ParameterWriter&
+        {
+            return write_vector(key, std::span<const T>{values}, delim);
+        }
+        // Rows split on row_delim, in the layout read by ParameterReader::try_parse_matrix.
+        template<WritableNum T>
+        auto write_matrix(str_v key, const utilities::Matrix<T>& matrix, str_v row_delim, str_v col_delim) -> ParameterWriter&
+        {
+            if (!begin_entry(key))
+            {
+                return *this;
+            }
+            for (size_t row = 0; row < matrix.rows(); row++)
+            {
+                if (row > 0)
+                {
+                    append(row_delim);
+                }
+                for (size_t col = 0; col < matrix.cols(); col++)
+                {
+                    if (col > 0)
+                    {
+                        append(col_delim);
+                    }
+                    append_num(matrix[row, col]);
+                }
+            }
+            append("\n");
+            return *this;
+        }
+        auto write_str(str_v key, str_v value) -> ParameterWriter&
+        {
+            if (!round_trips(value))
+            {
+                reject(value);
+                return *this;
+            }
+            if (!begin_entry(key))
+            {
+                return *this;
+            }
+            append(value);
+            append("\n");
+            return *this;
+        }
+
+        // The pending bytes: everything written so far by an in-memory writer.
+        auto view() const -> str_v
+        {
+            return str_v{m_buffer.data(), m_used};
+        }
+        // Writes the pending bytes to the file (a no-op in memory) and returns the first error met so far.
+        auto flush() -> std::expected<void, ReaderError>
+        {
+            if (m_file)
+            {
+                write_out();
+            }
+            if (m_error.has_value())
+            {
+                return std::unexpected(m_error.value());
+            }
+            return {};
+        }
+        // Flushes and closes the file; further writes stay in memory.
+        auto close() -> std::expected<void, ReaderError>
+        {
+            auto flushed = flush();
+            if (m_file && std::fclose(m_file.release()) != 0 && flushed)
+            {
+                ReaderError error{.args = m_path, .from = ReaderError::From::write, .kind = ReaderError::Kind::FileError};
+                return std::unexpected(error);
+            }
+            return flushed;
+        }
+    };
+}
+#endif
@@ -0,0 +1,4 @@
+// Explicit instantiations of the parsing templates listed in parameter_parser/instantiations.hpp, declared extern by reader.hpp.
+#include "parameter_parser/reader.hpp"
+
+PARAMETER_PARSER_NUM_TYPES(PARAMETER_PARSER_INSTANTIATE, )
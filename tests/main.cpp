@@ -1,7 +1,18 @@
 #include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <thread>
 #include "parameter_parser/reader.hpp"
 #include "parameter_parser/utilities.hpp"
 #include "parameter_parser/reader_error.hpp"
+#include "parameter_parser/binary_cache.hpp"
+#include "parameter_parser/parse_cache.hpp"
+#include "parameter_parser/reloadable_reader.hpp"
+#include "parameter_parser/layered_reader.hpp"
+#include "parameter_parser/writer.hpp"
+#include "parameter_parser/embedded.hpp"
+#include "parameter_parser/parameter_stream.hpp"
 
 using namespace std::string_view_literals;
 using namespace parameter_parser;
@@ -16,6 +27,13 @@ using Vec    = std::vector<T>;
 
 const char* file_name = "parameters.txt";
 
+// A temporary file name unique to the running test, so that tests run in parallel do not share files.
+auto test_temp_path(str_v suffix) -> std::filesystem::path
+{
+    const auto* info = testing::UnitTest::GetInstance()->current_test_info();
+    return std::filesystem::temp_directory_path() / (std::string{"parameter_parser_"} + info->test_suite_name() + "_" + info->name() + "_" + std::string{suffix});
+}
+
 TEST(UtilitiesTest, trim) 
 {
     std::string hello = "    hello world     ";
@@ -51,6 +69,115 @@ TEST(UtilitiesTest, VectorParsingErrorHandled)
     EXPECT_EQ(bad_vec_result.error(), "Meow, Meow!");
 }
 
+TEST(UtilitiesTest, VectorParsingIntoAppends) 
+{
+    Vec<int> values{7};
+    auto count = utilities::try_parse_vec_into<int>(" 1, 2 ,3", ",", values);
+
+    ASSERT_TRUE(count.has_value());
+    EXPECT_EQ(count.value(), 3);
+    EXPECT_EQ(values, (Vec<int>{7, 1, 2, 3}));
+    EXPECT_EQ(utilities::try_parse_vec_into<int>("", ",", values).value(), 0);
+}
+
+TEST(UtilitiesTest, VectorParsingIntoReportsOffsets) 
+{
+    Vec<double> values{1.0};
+    auto result = utilities::try_parse_vec_into<double>("1.5, x, 2.5,  y", ",", values);
+
+    ASSERT_FALSE(result.has_value());
+    ASSERT_EQ(result.error().size(), 2);
+    EXPECT_EQ(result.error()[0].token, "x");
+    EXPECT_EQ(result.error()[0].offset, 5);
+    EXPECT_EQ(result.error()[1].token, "y");
+    EXPECT_EQ(result.error()[1].offset, 14);
+    EXPECT_EQ(values, Vec<double>{1.0}) << "output should be left untouched on error";
+}
+
+TEST(UtilitiesTest, VectorParsingIntoSpan) 
+{
+    std::array<float, 3> storage{};
+    auto written = utilities::try_parse_vec_into<float>("1.5;2.5", ";", std::span{storage});
+    ASSERT_TRUE(written.has_value());
+    EXPECT_EQ(written.value(), 2);
+    EXPECT_EQ(storage[1], 2.5f);
+
+    auto overflow = utilities::try_parse_vec_into<float>("1;2;3;4", ";", std::span{storage});
+    ASSERT_FALSE(overflow.has_value());
+    EXPECT_EQ(overflow.error()[0].token, "4");
+}
+
+TEST(UtilitiesTest, VectorParsingIntoOutputIterator) 
+{
+    std::array<int, 4> storage{};
+    auto end = utilities::try_parse_vec_into<int>("4, 5, 6", ",", storage.begin());
+    ASSERT_TRUE(end.has_value());
+    EXPECT_EQ(end.value() - storage.begin(), 3);
+    EXPECT_EQ(storage, (std::array<int, 4>{4, 5, 6, 0}));
+
+    auto bad = utilities::try_parse_vec_into<int>("1, x, 2", ",", storage.begin());
+    ASSERT_FALSE(bad.has_value());
+    EXPECT_EQ(bad.error()[0].token, "x");
+}
+
+TEST(UtilitiesTest, VectorParsingPmr) 
+{
+    std::array<std::byte, 256> buffer{};
+    std::pmr::monotonic_buffer_resource arena{buffer.data(), buffer.size(), std::pmr::null_memory_resource()};
+    auto values = utilities::try_parse_vec<double>("1.5, 2.5", ",", &arena);
+
+    ASSERT_TRUE(values.has_value());
+    EXPECT_EQ(values->get_allocator().resource(), &arena);
+    EXPECT_EQ(values.value(), (std::pmr::vector<double>{1.5, 2.5}));
+}
+
+TEST(UtilitiesTest, MatrixParsing) 
+{
+    auto matrix = utilities::try_parse_matrix<int>(" 1, 2, 3 ; 4, 5, 6", ";", ",");
+    ASSERT_TRUE(matrix.has_value());
+    EXPECT_EQ(matrix->shape(), (utilities::MatrixShape{.rows = 2, .cols = 3}));
+    EXPECT_EQ((matrix.value()[1, 2]), 6);
+    EXPECT_EQ(matrix->row(1)[0], 4);
+    EXPECT_EQ(utilities::try_parse_matrix<int>("", ";", ",")->shape().size(), 0);
+
+    auto ragged = utilities::try_parse_matrix<int>("1, 2; 3, 4; 5", ";", ",");
+    ASSERT_FALSE(ragged.has_value());
+    EXPECT_EQ(ragged.error().token, "5");
+    EXPECT_EQ(ragged.error().offset, 12);
+    EXPECT_EQ(utilities::try_parse_matrix<int>("1, 2; 3, x", ";", ",").error().token, "x");
+}
+
+TEST(UtilitiesTest, SweepParsing) 
+{
+    auto range = utilities::try_parse_sweep<double>(" 1.0 : 0.1 : 1.9 ");
+    ASSERT_TRUE(range.has_value());
+    EXPECT_EQ(range->size(), 10);
+    EXPECT_DOUBLE_EQ(range.value()[3], 1.3);
+    static_assert(std::ranges::random_access_range<utilities::Sweep<double>>);
+    static_assert(std::ranges::borrowed_range<utilities::Sweep<double>>);
+    auto first_three = [](str_v value){return std::views::take(utilities::try_parse_sweep<int>(value).value(), 3);};
+    EXPECT_TRUE(std::ranges::equal(first_three("0:2:100"), Vec<int>{0, 2, 4})); // the Sweep was moved into the view
+    auto tail = std::ranges::find(utilities::try_parse_sweep<int>("1:4").value(), 3); // an iterator into a dead temporary
+    EXPECT_EQ(*tail, 3);
+    EXPECT_EQ(*++tail, 4);
+
+    auto linspace = utilities::try_parse_sweep<float>("linspace(0, 1, 5)");
+    ASSERT_TRUE(linspace.has_value());
+    EXPECT_EQ(linspace->to_vector(), (Vec<float>{0.0f, 0.25f, 0.5f, 0.75f, 1.0f}));
+
+    EXPECT_EQ(utilities::try_parse_sweep<int>("5:-2:0")->to_vector(), (Vec<int>{5, 3, 1}));
+    EXPECT_EQ(utilities::try_parse_sweep<int>("1:3")->to_vector(), (Vec<int>{1, 2, 3}));
+    EXPECT_TRUE(utilities::try_parse_sweep<int>("3:1:1")->empty());
+    EXPECT_EQ(utilities::try_parse_sweep<int>("0:0:3").error(), "0:0:3");
+    EXPECT_EQ(utilities::try_parse_sweep<int>("linspace(0, 10, 4)").error(), "linspace(0, 10, 4)");
+    EXPECT_EQ(utilities::try_parse_sweep<double>("1:x:2").error(), "x");
+    EXPECT_FALSE(utilities::is_sweep("1, 2, 3", ","));
+    EXPECT_FALSE(utilities::is_sweep("1:2:3", ":"));
+    EXPECT_FALSE(utilities::is_sweep("12:30, 13:45", ","));
+    EXPECT_FALSE(utilities::is_sweep("1:x:2", ","));
+    EXPECT_FALSE(utilities::try_parse_sweep<int64_t>("0:1:9000000000000000000").has_value());
+}
+
 class ReaderTest : public testing::Test
 {
 protected:
@@ -175,4 +302,1017 @@ TEST_F(ReaderTest, StringExitHandled)
 {  
     EXPECT_DEATH(reader->get_str_or_exit("non-existing str"),
                 "Exiting with ParameterParserError: from: .*, kind: .*, args: .*");
-}
\ No newline at end of file
+}
+TEST(ReaderBuildTest, MappedMatchesBuffered) 
+{
+    auto buffered = reader::ParameterReader::build(file_name, "=>", reader::Mode::Strict, reader::Load::Buffered);
+    auto mapped   = reader::ParameterReader::build(file_name, "=>", reader::Mode::Strict, reader::Load::Mapped);
+
+    ASSERT_TRUE(buffered.has_value());
+    ASSERT_TRUE(mapped.has_value());
+    EXPECT_EQ(mapped->try_get_str("my_str").value(), buffered->try_get_str("my_str").value());
+    EXPECT_EQ(mapped->try_parse_num<int>("my_int").value(), 42);
+    EXPECT_EQ(mapped->try_parse_vector<float>("good_vector", ",").value(), buffered->try_parse_vector<float>("good_vector", ",").value());
+}
+
+TEST(ReaderBuildTest, CopyOutlivesOriginal) 
+{
+    std::optional<reader::ParameterReader> copy{};
+    {
+        auto original = reader::ParameterReader::build(file_name, "=>", reader::Mode::Strict, reader::Load::Mapped);
+        ASSERT_TRUE(original.has_value());
+        copy = original.value();
+    }
+    EXPECT_EQ(copy->try_get_str("my_str").value(), "hello world");
+}
+
+TEST(ReaderBuildTest, ErrorsPointIntoTheSource) 
+{
+    std::optional<ReaderError> vector_error{};
+    std::optional<ReaderError> num_error{};
+    {
+        auto built = reader::ParameterReader::build(file_name, "=>");
+        ASSERT_TRUE(built.has_value());
+        vector_error = built->try_parse_vector<float>("bad_vector", ",").error();
+        num_error    = built->try_parse_num<float>("my_bad_float").error();
+    }
+    EXPECT_EQ(vector_error->args, "XXX, YYY, ?!+");
+    EXPECT_EQ(vector_error->decode(), R"(from: "try_parse_vec", kind: "ParseError", args: "XXX, YYY, ?!+")");
+    std::ostringstream streamed{};
+    streamed << *vector_error;
+    EXPECT_EQ(streamed.str(), vector_error->decode());
+    EXPECT_EQ(std::format("{}", *num_error), num_error->decode());
+
+    ASSERT_TRUE(vector_error->location().has_value());
+    EXPECT_EQ(vector_error->location()->line, 2);
+    EXPECT_EQ(vector_error->location()->column, 15);
+    ASSERT_TRUE(num_error->location().has_value());
+    EXPECT_EQ(num_error->location()->line, 6);
+    EXPECT_EQ(num_error->location()->column, 17);
+}
+
+TEST(ReaderBuildTest, MissingFileIsFileError) 
+{
+    auto missing = reader::ParameterReader::build("does-not-exist.txt", "=>", reader::Mode::Strict, reader::Load::Mapped);
+
+    ASSERT_FALSE(missing.has_value());
+    EXPECT_EQ(missing.error().kind, ReaderError::Kind::FileError);
+    EXPECT_EQ(missing.error().args, "does-not-exist.txt");
+    EXPECT_FALSE(missing.error().location().has_value());
+}
+
+TEST(ReaderBuildTest, BuildsFromBuffersStreamsAndDescriptors) 
+{
+    std::string_view padded_path = "parameters.txt.unterminated";
+    auto from_view = reader::ParameterReader::build(padded_path.substr(0, 14), "=>");
+    ASSERT_TRUE(from_view.has_value());
+
+    std::string text = "my_int => 42\nmy_str => hello world\n";
+    auto from_buffer = reader::ParameterReader::build_from_buffer(text, "=>");
+    ASSERT_TRUE(from_buffer.has_value());
+    EXPECT_EQ(from_buffer->try_parse_num<int>("my_int").value(), 42);
+    auto bad_line = reader::ParameterReader::build_from_buffer("my_int => 42\nno delimiter", "=>");
+    ASSERT_FALSE(bad_line.has_value());
+    EXPECT_EQ(bad_line.error().location()->line, 2);
+
+    std::ifstream file{file_name};
+    auto from_stream = reader::ParameterReader::build_from_stream(file, "=>");
+    ASSERT_TRUE(from_stream.has_value());
+    EXPECT_EQ(from_stream->try_parse_vector<float>("good_vector", ",").value(), from_view->try_parse_vector<float>("good_vector", ",").value());
+
+#ifdef PARAMETER_PARSER_HAS_MMAP
+    int fds[2]{};
+    ASSERT_EQ(::pipe(fds), 0);
+    ASSERT_EQ(::write(fds[1], text.data(), text.size()), static_cast<ssize_t>(text.size()));
+    ::close(fds[1]);
+    auto from_pipe = reader::ParameterReader::build_from_fd(fds[0], "=>", reader::Mode::Strict, reader::Load::Mapped); // not mappable: read
+    ::close(fds[0]);
+    ASSERT_TRUE(from_pipe.has_value());
+    EXPECT_EQ(from_pipe->try_get_str("my_str").value(), "hello world");
+    EXPECT_EQ(reader::ParameterReader::build_from_fd(-1, "=>").error().kind, ReaderError::Kind::FileError);
+#endif
+}
+
+class CountingResource : public std::pmr::memory_resource
+{
+public:
+    size_t allocations = 0;
+
+private:
+    auto do_allocate(size_t bytes, size_t alignment) -> void* override
+    {
+        allocations++;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+    auto do_deallocate(void* ptr, size_t bytes, size_t alignment) -> void override
+    {
+        std::pmr::new_delete_resource()->deallocate(ptr, bytes, alignment);
+    }
+    auto do_is_equal(const std::pmr::memory_resource& other) const noexcept -> bool override
+    {
+        return this == &other;
+    }
+};
+
+TEST(ReaderBuildTest, BuildsFromMemoryResource) 
+{
+    CountingResource counting{};
+    {
+        std::pmr::monotonic_buffer_resource arena{&counting};
+        auto built = reader::ParameterReader::build(file_name, "=>", reader::Mode::Strict, reader::Load::Buffered, &arena);
+        ASSERT_TRUE(built.has_value());
+        EXPECT_GT(counting.allocations, 0);
+        built->freeze();
+
+        auto values = built->try_parse_vector<float>("good_vector", ",", &arena);
+        ASSERT_TRUE(values.has_value());
+        EXPECT_EQ(values->size(), 10);
+        EXPECT_EQ(built->try_get_str("my_str").value(), "hello world");
+    }
+}
+
+TEST_F(ReaderTest, ParsingMatrices) 
+{
+    auto matrix = reader->try_parse_matrix<double>("coupling", ";", ",");
+    ASSERT_TRUE(matrix.has_value());
+    EXPECT_EQ(matrix->rows(), 3);
+    EXPECT_EQ(matrix->cols(), 2);
+    EXPECT_EQ(matrix->values().size(), 6);
+    EXPECT_EQ((matrix.value()[2, 1]), 2.0);
+
+    std::array<double, 6> storage{};
+    auto shape = reader->try_parse_matrix_into<double>("coupling", ";", ",", std::span{storage});
+    ASSERT_TRUE(shape.has_value());
+    EXPECT_EQ(storage[1], 0.5);
+    EXPECT_FALSE(reader->try_parse_matrix_into<double>("coupling", ";", ",", std::span{storage}.first(5)).has_value());
+
+    auto ragged = reader->try_parse_matrix<int>("ragged_matrix", ";", ",");
+    ASSERT_FALSE(ragged.has_value());
+    EXPECT_EQ(ragged.error().kind, ReaderError::Kind::ParseError);
+    EXPECT_EQ(ragged.error().args, "3");
+    EXPECT_EQ(ragged.error().location()->line, 9);
+    EXPECT_EQ(reader->try_parse_matrix<int>("missing", ";", ",").error().kind, ReaderError::Kind::KeyError);
+}
+
+TEST_F(ReaderTest, ParsingSweeps) 
+{
+    auto sweep = reader->try_parse_sweep<double>("sweep");
+    ASSERT_TRUE(sweep.has_value());
+    EXPECT_EQ(sweep->size(), 10);
+    EXPECT_DOUBLE_EQ(sweep->back(), 1.9);
+
+    auto expanded = reader->try_parse_vector<double>("sweep", ",");
+    ASSERT_TRUE(expanded.has_value());
+    ASSERT_EQ(expanded->size(), good_vec_res->size());
+    for (size_t i = 0; i < expanded->size(); i++)
+    {
+        EXPECT_FLOAT_EQ(static_cast<float>(expanded.value()[i]), good_vec_res.value()[i]);
+    }
+    EXPECT_EQ(reader->try_parse_vector<int>("int_sweep", ",").value(), (Vec<int>{10, 8, 6, 4, 2, 0}));
+
+    std::array<int, 4> storage{};
+    EXPECT_FALSE(reader->try_parse_vector_into<int>("int_sweep", ",", std::span{storage}).has_value());
+    auto bad = reader->try_parse_sweep<int>("my_str");
+    ASSERT_FALSE(bad.has_value());
+    EXPECT_EQ(bad.error().from, ReaderError::From::try_parse_sweep);
+
+    auto times = ParameterReader::build_from_buffer("times => 12:30, 13:45\n", "=>"); // a list whose values contain ':'
+    ASSERT_TRUE(times.has_value());
+    EXPECT_EQ(times->try_parse_vector<int>("times", ",").value(), (Vec<int>{12, 13}));
+
+    auto huge = ParameterReader::build_from_buffer("huge => 0:1:1e14\n", "=>"); // fine as a view, too long to materialize
+    ASSERT_TRUE(huge.has_value());
+    EXPECT_EQ(huge->try_parse_sweep<double>("huge")->size(), 100'000'000'000'001);
+    auto materialized = huge->try_parse_vector<double>("huge", ",");
+    ASSERT_FALSE(materialized.has_value());
+    EXPECT_EQ(materialized.error().kind, ReaderError::Kind::ParseError);
+    EXPECT_EQ(materialized.error().args, "0:1:1e14");
+}
+
+TEST_F(ReaderTest, ParsingVectorsIntoCallerStorage) 
+{
+    std::array<int, 4> storage{};
+    auto written = reader->try_parse_vector_into<int>("int_list", "and", std::span{storage});
+    ASSERT_TRUE(written.has_value());
+    EXPECT_EQ(written.value(), 3);
+    EXPECT_EQ(storage, (std::array<int, 4>{1, 2, 3, 0}));
+
+    Vec<double> values{};
+    auto end = reader->try_parse_vector_into<double>("good_vector", ",", std::back_inserter(values));
+    ASSERT_TRUE(end.has_value());
+    EXPECT_EQ(values.size(), 10);
+
+    auto bad = reader->try_parse_vector_into<double>("bad_vector", ",", std::back_inserter(values));
+    ASSERT_FALSE(bad.has_value());
+    EXPECT_EQ(bad.error().args, "XXX, YYY, ?!+");
+    EXPECT_EQ(reader->try_parse_vector_into<int>("missing", ",", std::span{storage}).error().kind, ReaderError::Kind::KeyError);
+}
+
+enum class SolverMode
+{
+    fast,
+    accurate,
+};
+template<>
+struct utilities::EnumNames<SolverMode>
+{
+    static constexpr std::array<std::pair<str_v, SolverMode>, 2> names{{{"fast", SolverMode::fast}, {"accurate", SolverMode::accurate}}};
+};
+
+TEST(ReaderBuildTest, ParsingExtendedTypes)
+{
+    using namespace std::chrono_literals;
+    auto reader = ParameterReader::build_from_buffer("verbose => Yes\n"
+                                                     "mode => fast\n"
+                                                     "timeout => 1.5 s\n"
+                                                     "period => 250ms\n"
+                                                     "impedance => (1.5, -2)\n"
+                                                     "position => 1, 2.5, -3\n"
+                                                     "flags => on, off, 1\n"
+                                                     "my_int => 42\n"
+                                                     "my_str => hello world\n"
+                                                     "modes => fast, accurate\n"
+                                                     "[solver]\n"
+                                                     "flags => yes, no\n", "=>");
+    ASSERT_TRUE(reader.has_value());
+    EXPECT_EQ(reader->try_parse<bool>("verbose").value(), true);
+    EXPECT_EQ(reader->try_parse<SolverMode>("mode").value(), SolverMode::fast);
+    EXPECT_EQ(reader->try_parse<std::chrono::milliseconds>("timeout").value(), 1500ms);
+    EXPECT_EQ(reader->try_parse<std::chrono::duration<double>>("period").value().count(), 0.25);
+    EXPECT_EQ(reader->try_parse<std::complex<double>>("impedance").value(), (std::complex<double>{1.5, -2.0}));
+    EXPECT_EQ(reader->try_parse<int>("my_int").value(), 42);
+
+    auto position = reader->try_parse_array<float, 3>("position", ",");
+    ASSERT_TRUE(position.has_value());
+    EXPECT_EQ(position.value(), (std::array<float, 3>{1.0f, 2.5f, -3.0f}));
+    EXPECT_EQ(reader->try_parse_vector<bool>("flags", ",").value(), (Vec<bool>{true, false, true}));
+
+    EXPECT_EQ(reader->try_parse<bool>("my_str").error().args, "hello world");
+    EXPECT_EQ(reader->try_parse<SolverMode>("my_str").error().kind, ReaderError::Kind::ParseError);
+    EXPECT_EQ(reader->try_parse<std::chrono::seconds>("timeout").error().args, "1.5 s"); // not a whole number of seconds
+    EXPECT_EQ(reader->try_parse<std::chrono::seconds>("my_str").error().from, ReaderError::From::try_parse);
+    EXPECT_FALSE(utilities::parse_value<std::chrono::seconds>("nan s").has_value());
+    EXPECT_FALSE(utilities::parse_value<std::chrono::duration<double>>("inf").has_value());
+    EXPECT_EQ(utilities::parse_value<std::chrono::nanoseconds>("9223372036854775807ns").value().count(), std::numeric_limits<int64_t>::max());
+    EXPECT_FALSE(utilities::parse_value<std::chrono::nanoseconds>("9223372036854775808ns").has_value()); // 2^63
+    EXPECT_FALSE(utilities::parse_value<std::chrono::nanoseconds>("9223372036854775808.0ns").has_value());
+    EXPECT_EQ(utilities::parse_value<std::chrono::nanoseconds>("9007199254740993").value().count(), 9007199254740993); // 2^53 + 1
+    EXPECT_EQ(utilities::parse_value<std::chrono::nanoseconds>("9007199254740993 us").value().count(), 9007199254740993000);
+    EXPECT_EQ(utilities::parse_value<std::chrono::nanoseconds>("9223372036854776 us").error(), "9223372036854776 us");
+    EXPECT_EQ(utilities::parse_value<std::chrono::seconds>("3000 ms").value(), 3s);
+    EXPECT_EQ(utilities::parse_value<std::chrono::seconds>("2 min").value(), 120s);
+    EXPECT_FALSE(utilities::parse_value<std::chrono::seconds>("1500 ms").has_value());
+    EXPECT_EQ((reader->try_parse_array<float, 2>("position", ",").error().args), "-3");
+    EXPECT_EQ((reader->try_parse_array<float, 4>("position", ",").error().args), "1, 2.5, -3");
+    EXPECT_EQ(reader->try_parse_vector<SolverMode>("flags", ",").error().args, "on, off, 1");
+    EXPECT_EQ(reader->try_parse<bool>("missing").error().kind, ReaderError::Kind::KeyError);
+
+    struct Settings
+    {
+        bool verbose{};
+        SolverMode mode{};
+        std::array<double, 3> position{};
+        std::vector<bool> flags{};
+    };
+    using SettingsSchema = reader::Schema<Settings,
+        reader::Field<"verbose", &Settings::verbose>,
+        reader::Field<"mode", &Settings::mode>,
+        reader::Field<"position", &Settings::position>,
+        reader::Field<"flags", &Settings::flags>>;
+    auto settings = reader->try_bind<SettingsSchema>();
+    ASSERT_TRUE(settings.has_value());
+    EXPECT_EQ(settings->mode, SolverMode::fast);
+    EXPECT_EQ(settings->position[2], -3.0);
+    EXPECT_EQ(settings->flags, (Vec<bool>{true, false, true}));
+
+    EXPECT_EQ(reader->section("solver").try_parse_vector<bool>("flags", ",").value(), (Vec<bool>{true, false}));
+    reader::LayeredReader layered{std::make_shared<const ParameterReader>(reader.value())};
+    EXPECT_EQ(layered.try_parse_vector<SolverMode>("flags", ",").error().args, "on, off, 1");
+    auto [modes, mode] = layered.resolve_or_exit(reader::vec<SolverMode>("modes", ","), reader::value<SolverMode>("mode"));
+    EXPECT_EQ(modes.size(), 2);
+    EXPECT_EQ(mode, SolverMode::fast);
+}
+
+TEST(ReaderBuildTest, ConcurrentConstLookups) 
+{
+    const auto reader = reader::ParameterReader::build(file_name, "=>");
+    ASSERT_TRUE(reader.has_value());
+
+    std::vector<int> failures(4, 0);
+    std::vector<std::thread> workers{};
+    for (size_t i = 0; i < failures.size(); i++)
+    {
+        workers.emplace_back([&reader, &failure = failures[i]]
+        {
+            for (int n = 0; n < 1000; n++)
+            {
+                failure += reader->try_parse_num<int>("my_int").value_or(0) != 42;
+                failure += reader->try_parse_vector<float>("good_vector", ",").value_or(Vec<float>{}).size() != 10;
+                failure += reader->try_get_str("non-existing str").has_value();
+            }
+        });
+    }
+    for (auto& worker : workers)
+    {
+        worker.join();
+    }
+    EXPECT_EQ(failures, std::vector<int>(4, 0));
+}
+
+TEST(FrozenIndexTest, FindsEveryKeyAndRejectsOthers) 
+{
+    std::vector<std::string> keys{};
+    for (int i = 0; i < 5000; i++)
+    {
+        keys.push_back("key_" + std::to_string(i));
+    }
+    ParameterMap map{};
+    for (const auto& key : keys)
+    {
+        map.emplace(key, key);
+    }
+    auto index = reader::FrozenIndex::build(map);
+
+    ASSERT_EQ(index.size(), keys.size());
+    for (const auto& key : keys)
+    {
+        const str_v* value = index.find(key);
+        ASSERT_NE(value, nullptr) << key;
+        EXPECT_EQ(*value, key);
+    }
+    EXPECT_EQ(index.find("key_5000"), nullptr);
+    EXPECT_EQ(index.find(""), nullptr);
+    EXPECT_EQ(reader::FrozenIndex::build(ParameterMap{}).find("key_0"), nullptr);
+}
+
+TEST(FrozenIndexTest, PrefixOrderUsesTheResource) 
+{
+    CountingResource counting{};
+    reader::FrozenIndex empty{&counting};
+    EXPECT_EQ(counting.allocations, 1);
+
+    ParameterMap map{{"a.x", "1"}, {"a.y", "2"}, {"b", "3"}};
+    auto index = reader::FrozenIndex::build(map, &counting);
+    size_t built = counting.allocations;
+    EXPECT_EQ(std::ranges::distance(index.with_prefix("a.")), 2);
+    EXPECT_EQ(counting.allocations, built + 1);
+
+    auto moved = std::move(index);
+    EXPECT_EQ(std::ranges::distance(moved.with_prefix("a.")), 2);
+    EXPECT_EQ(std::ranges::distance(index.with_prefix("a.")), 0);
+}
+
+TEST_F(ReaderTest, FrozenReaderKeepsResults) 
+{
+    reader->freeze();
+
+    ASSERT_TRUE(reader->is_frozen());
+    EXPECT_EQ(reader->try_parse_vector<float>("good_vector", ",").value(), good_vec_res.value());
+    EXPECT_EQ(reader->try_parse_num<int>("my_int").value(), 42);
+    EXPECT_EQ(reader->try_get_str("my_str").value(), "hello world");
+    EXPECT_EQ(reader->try_get_str("non-existing str").error().kind, ReaderError::Kind::KeyError);
+}
+
+TEST(SectionTest, IniSectionsPrefixTheirKeys) 
+{
+    std::string text = "top => 1\n[solver]\ntol => 1e-6\nmaxit => 100\n  [ solver.linear ]\nmethod => cg\n[]\nlattice.L => 32\n";
+    auto built = reader::ParameterReader::build_from_buffer(text, "=>");
+    ASSERT_TRUE(built.has_value());
+
+    EXPECT_EQ(built->try_parse_num<int>("top").value(), 1);
+    EXPECT_EQ(built->try_parse_num<int>("solver.maxit").value(), 100);
+    EXPECT_EQ(built->try_get_str("solver.linear.method").value(), "cg");
+    EXPECT_EQ(built->try_parse_num<int>("lattice.L").value(), 32);
+
+    auto solver = built->section("solver");
+    EXPECT_EQ(solver.name(), "solver");
+    EXPECT_EQ(solver.try_parse_num<double>("tol").value(), 1e-6);
+    EXPECT_EQ(solver.section("linear").try_get_str("method").value(), "cg");
+    EXPECT_EQ(solver.try_parse_num<int>("missing").error().args, "solver.missing");
+
+    auto keys_of = [](const auto& entries)
+    {
+        Vec<std::string_view> keys{};
+        std::ranges::transform(entries, std::back_inserter(keys), &reader::ParameterReader::Entry::key);
+        return keys;
+    };
+    auto expected_keys = Vec<std::string_view>{"solver.linear.method", "solver.maxit", "solver.tol"};
+    EXPECT_EQ(keys_of(solver.entries()), expected_keys);
+    built->freeze();
+    EXPECT_EQ(keys_of(solver.entries()), expected_keys);
+    EXPECT_EQ(keys_of(built->entries_with_prefix("lattice.")), Vec<std::string_view>{"lattice.L"});
+    EXPECT_TRUE(built->entries_with_prefix("none.").empty());
+}
+
+TEST(WriterTest, RoundTripsThroughTheReader) 
+{
+    Vec<double> doubles{0.1, 1.0 / 3.0, -2.5e-300, 1e308, std::numeric_limits<double>::denorm_min(), std::numeric_limits<double>::max()};
+    Vec<float> floats{0.1f, 1.0f / 3.0f, -3.4e38f, std::numeric_limits<float>::min()};
+    Vec<int64_t> ints{std::numeric_limits<int64_t>::min(), -1, 0, std::numeric_limits<int64_t>::max()};
+    utilities::Matrix<double> coupling{Vec<double>{1.0, 0.5, 0.5, 1.0 / 7.0}, utilities::MatrixShape{.rows = 2, .cols = 2}};
+
+    writer::ParameterWriter out{"=>"};
+    out.write_num("my_double", 1.0 / 3.0).write_num("my_int", uint64_t{18446744073709551615u}).write_str("my_str", "hello world");
+    out.write_vector("doubles", doubles, ", ").write_vector("floats", floats, ",").write_vector("ints", ints, " and ");
+    out.write_matrix("coupling", coupling, "; ", ", ");
+    ASSERT_TRUE(out.flush().has_value());
+
+    auto built = reader::ParameterReader::build_from_buffer(out.view(), "=>");
+    ASSERT_TRUE(built.has_value());
+    EXPECT_EQ(built->try_parse_num<double>("my_double").value(), 1.0 / 3.0);
+    EXPECT_EQ(built->try_parse_num<uint64_t>("my_int").value(), 18446744073709551615u);
+    EXPECT_EQ(built->try_get_str("my_str").value(), "hello world");
+    EXPECT_EQ(built->try_parse_vector<double>("doubles", ",").value(), doubles);
+    EXPECT_EQ(built->try_parse_vector<float>("floats", ",").value(), floats);
+    EXPECT_EQ(built->try_parse_vector<int64_t>("ints", "and").value(), ints);
+    auto matrix = built->try_parse_matrix<double>("coupling", ";", ",").value();
+    EXPECT_EQ(matrix.shape(), coupling.shape());
+    EXPECT_TRUE(std::ranges::equal(matrix.values(), coupling.values()));
+}
+
+TEST(WriterTest, RejectsEntriesThatDoNotRoundTrip) 
+{
+    writer::ParameterWriter out{"=>"};
+    out.write_str("my_str", "hello").write_str("padded", " hello ").write_num("a => b", 1).write_str("line\nbreak", "x");
+    ASSERT_FALSE(out.flush().has_value());
+    EXPECT_EQ(out.flush().error().args, " hello ");
+    EXPECT_EQ(out.view(), "my_str => hello\n");
+
+    writer::ParameterWriter moved{std::move(out)};
+    EXPECT_EQ(moved.view(), "my_str => hello\n");
+    EXPECT_TRUE(out.view().empty());
+}
+
+TEST(WriterTest, FlushesSmallBuffersToFile) 
+{
+    auto path = test_temp_path("out.txt").string();
+    Vec<double> values(1000);
+    std::ranges::generate(values, [i = 0]() mutable {return 1.0 / ++i;});
+    {
+        auto out = writer::ParameterWriter::open(path, "=>", 128);
+        ASSERT_TRUE(out.has_value());
+        out->write_vector("values", values, ", ").write_num("count", values.size());
+        ASSERT_TRUE(out->close().has_value());
+    }
+    auto built = reader::ParameterReader::build(path, "=>");
+    ASSERT_TRUE(built.has_value());
+    EXPECT_EQ(built->try_parse_vector<double>("values", ",").value(), values);
+    EXPECT_EQ(built->try_parse_num<size_t>("count").value(), values.size());
+    std::filesystem::remove(path);
+
+    auto missing = writer::ParameterWriter::open("no-such-directory/out.txt", "=>");
+    ASSERT_FALSE(missing.has_value());
+    EXPECT_EQ(missing.error().kind, ReaderError::Kind::FileError);
+}
+
+TEST(ExternalArrayTest, MapsBinaryFilesNextToTheParameterFile)
+{
+    std::filesystem::path directory{test_temp_path("arrays")};
+    std::filesystem::create_directories(directory);
+    Vec<float> weights{0.5f, 1.5f, -2.0f, 4.0f, 8.0f, 16.0f};
+    {
+        std::ofstream out{directory / "weights.f32", std::ios::binary};
+        out.write(reinterpret_cast<const char*>(weights.data()), static_cast<std::streamsize>(weights.size() * sizeof(float)));
+        std::ofstream parameters{directory / "parameters.txt"};
+        parameters << "weights => @weights.f32\n"
+                   << "grid => @weights.f32[2, 3]\n"
+                   << "bad_shape => @weights.f32[4, 2]\n"
+                   << "typed => @weights.f32:f32\n"
+                   << "missing => @nowhere.f32\n"
+                   << "[layer]\n"
+                   << "bias => @weights.f32\n";
+    }
+    auto built = reader::ParameterReader::build((directory / "parameters.txt").string(), "=>");
+    ASSERT_TRUE(built.has_value());
+
+    auto mapped = built->try_get_array<float>("weights");
+    ASSERT_TRUE(mapped.has_value());
+    EXPECT_TRUE(std::ranges::equal(mapped.value(), weights));
+    EXPECT_EQ(built->try_get_array<float>("typed")->data(), mapped->data()); // mapped once
+    auto copy = built.value();
+    EXPECT_EQ(copy.try_get_array<float>("weights")->data(), mapped->data());  // and shared with later copies
+    EXPECT_EQ(built->section("layer").try_get_array<float>("bias")->size(), weights.size());
+    EXPECT_TRUE(built->try_get_array<float>("grid").has_value());
+
+    EXPECT_EQ(built->try_get_array<double>("weights").error().kind, ReaderError::Kind::ParseError);
+    EXPECT_EQ(built->try_get_array<float>("bad_shape").error().args, "@weights.f32[4, 2]");
+    EXPECT_EQ(built->try_get_array<float>("my_int").error().kind, ReaderError::Kind::KeyError);
+    auto missing = built->try_get_array<float>("missing");
+    ASSERT_FALSE(missing.has_value());
+    EXPECT_EQ(missing.error().kind, ReaderError::Kind::FileError);
+    EXPECT_EQ(missing.error().args, (directory / "nowhere.f32").string());
+
+    auto ref = utilities::parse_array_ref("@data/grid.bin:i64[10]");
+    ASSERT_TRUE(ref.has_value());
+    EXPECT_EQ(ref->path, "data/grid.bin");
+    EXPECT_EQ(ref->dtype, utilities::DType::i64);
+    EXPECT_EQ(ref->shape->rows, 10);
+    EXPECT_EQ(ref->shape->cols, 1);
+    EXPECT_EQ(utilities::parse_array_ref("@grid.f32[2, x]").error(), "[2, x]");
+    std::filesystem::remove_all(directory);
+}
+
+struct BoundParameters
+{
+    int my_int{};
+    double my_double{};
+    std::string my_str{};
+    Vec<float> good_vector{};
+    Vec<int64_t> int_list{};
+};
+using BoundSchema = reader::Schema<BoundParameters,
+    reader::Field<"my_int", &BoundParameters::my_int>,
+    reader::Field<"my_double", &BoundParameters::my_double>,
+    reader::Field<"my_str", &BoundParameters::my_str>,
+    reader::Field<"good_vector", &BoundParameters::good_vector>,
+    reader::Field<"int_list", &BoundParameters::int_list, "and">>;
+
+struct BadBoundParameters
+{
+    float my_bad_float{};
+    Vec<float> bad_vector{};
+    int missing{};
+    int my_int{};
+};
+using BadBoundSchema = reader::Schema<BadBoundParameters,
+    reader::Field<"my_bad_float", &BadBoundParameters::my_bad_float>,
+    reader::Field<"bad_vector", &BadBoundParameters::bad_vector>,
+    reader::Field<"missing", &BadBoundParameters::missing>,
+    reader::Field<"my_int", &BadBoundParameters::my_int>>;
+
+TEST_F(ReaderTest, BindSchema) 
+{
+    auto bound = reader->try_bind<BoundSchema>();
+
+    ASSERT_TRUE(bound.has_value());
+    EXPECT_EQ(bound->my_int, 42);
+    EXPECT_EQ(bound->my_double, 3.14159265359);
+    EXPECT_EQ(bound->my_str, "hello world");
+    EXPECT_EQ(bound->good_vector, good_vec_res.value());
+    EXPECT_EQ(bound->int_list, (Vec<int64_t>{1, 2, 3}));
+}
+
+TEST_F(ReaderTest, BindSchemaReportsAllErrors) 
+{
+    auto bound = reader->try_bind<BadBoundSchema>();
+
+    ASSERT_FALSE(bound.has_value());
+    ASSERT_EQ(bound.error().size(), 3);
+    EXPECT_EQ(bound.error()[0].kind, ReaderError::Kind::ParseError);
+    EXPECT_EQ(bound.error()[0].args, "my_bad_float: meow");
+    EXPECT_EQ(bound.error()[1].args, "bad_vector: XXX, YYY, ?!+");
+    EXPECT_EQ(bound.error()[2].kind, ReaderError::Kind::KeyError);
+    EXPECT_EQ(bound.error()[2].args, "missing");
+    EXPECT_EQ(bound.error()[2].from, ReaderError::From::try_bind);
+
+    EXPECT_DEATH(reader->bind_or_exit<BadBoundSchema>(), "Exiting with 3 ParameterParserError");
+}
+
+using EmbeddedParams = reader::EmbeddedParameters<"good_vector => 1.0, 1.1, 1.2, 1.3, 1.4, 1.5, 1.6, 1.7, 1.8, 1.9\n"
+                                                  "my_str  => hello world\n"
+                                                  "my_double => 3.14159265359\n"
+                                                  "my_int => 42\n"
+                                                  "my_bad_float => meow\n"
+                                                  "int_list => 1 and 2 and 3\n"
+                                                  "my_int => 7\n"
+                                                  "[solver]\n"
+                                                  "tol => 1e-9\n", "=>">;
+
+TEST_F(ReaderTest, EmbeddedParametersFoldToConstants)
+{
+    static_assert(EmbeddedParams::num<int32_t, "my_int"> == 42);
+    static_assert(EmbeddedParams::num<double, "solver.tol"> == 1e-9);
+    static_assert(EmbeddedParams::str<"my_str"> == "hello world");
+    static_assert(EmbeddedParams::array<int64_t, "int_list", "and"> == std::array<int64_t, 3>{1, 2, 3});
+    static_assert(EmbeddedParams::size() == 7 && !EmbeddedParams::contains("tol"));
+
+    EXPECT_EQ((EmbeddedParams::num<double, "my_double">), reader->try_parse_num<double>("my_double").value());
+    auto good_vector = EmbeddedParams::array<float, "good_vector">;
+    EXPECT_TRUE(std::ranges::equal(good_vector, reader->try_parse_vector<float>("good_vector", ",").value()));
+    EXPECT_EQ(EmbeddedParams::try_parse_num<float>("my_bad_float").error().kind, ReaderError::Kind::ParseError);
+    EXPECT_EQ(EmbeddedParams::try_parse_num<float>("my_bad_float").error().location()->line, 5);
+    EXPECT_EQ(EmbeddedParams::try_get_str("missing").error().kind, ReaderError::Kind::KeyError);
+
+    auto bound = EmbeddedParams::try_bind<BadBoundSchema>();
+    ASSERT_FALSE(bound.has_value());
+    EXPECT_EQ(bound.error().size(), 3);
+}
+
+TEST(UtilitiesTest, ConstexprNumbersMatchFromChars)
+{
+    static constexpr std::array floats{"3.14159265359"sv, "-0.5"sv, "1e-9"sv, "2.5E+3x"sv, ".25"sv, "7e"sv, "1e30"sv, "-0"sv, "inf"sv, "123456.789e-3"sv, "0.1"sv};
+    static constexpr auto at_compile_time = []
+    {
+        std::array<double, floats.size()> values{};
+        std::ranges::transform(floats, values.begin(), [](str_v text){return utilities::parse_num_handled<double>(text).value();});
+        return values;
+    }();
+    for (size_t i = 0; i < floats.size(); i++)
+    {
+        EXPECT_EQ(std::bit_cast<uint64_t>(at_compile_time[i]), std::bit_cast<uint64_t>(utilities::parse_num_handled<double>(floats[i]).value())) << floats[i];
+    }
+    static_assert(utilities::parse_num_handled<float>("0.1").value() == 0.1f);
+    static_assert(utilities::parse_num_handled<int8_t>("-128").value() == -128);
+    static_assert(utilities::parse_num_handled<uint8_t>("256").value() == 0); // out of range, like from_chars
+    static_assert(utilities::parse_num_handled<int32_t>("12abc").value() == 12);
+    static_assert(!utilities::parse_num_handled<uint32_t>("-1").has_value());
+    static_assert(!utilities::parse_num_handled<double>("meow").has_value());
+}
+
+TEST(LayeredReaderTest, UpperLayersShadowTheBase) 
+{
+    auto base = std::make_shared<const ParameterReader>(ParameterReader::build(file_name, "=>").value());
+    reader::LayeredReader layered{base};
+    ASSERT_TRUE(layered.push_overrides(std::array{"my_int=7"sv, "my_str = site"sv}).has_value());
+    ASSERT_TRUE(layered.push_overrides(std::array{"my_str=run"sv, "extra=2.5"sv}).has_value());
+
+    EXPECT_EQ(layered.layer_count(), 3);
+    EXPECT_EQ(layered.try_parse_num<int>("my_int").value(), 7);
+    EXPECT_EQ(layered.try_get_str("my_str").value(), "run");
+    EXPECT_EQ(layered.try_parse_num<double>("extra").value(), 2.5);
+    EXPECT_EQ(layered.try_parse_vector<int64_t>("int_list", "and").value(), (Vec<int64_t>{1, 2, 3}));
+    EXPECT_EQ(layered.try_get_str("missing").error().kind, ReaderError::Kind::KeyError);
+    EXPECT_EQ(layered.try_parse_num<float>("my_bad_float").error().location()->line, 6); // reported by the base
+
+    auto bound = layered.try_bind<BoundSchema>();
+    ASSERT_TRUE(bound.has_value());
+    EXPECT_EQ(bound->my_int, 7);
+    EXPECT_EQ(bound->my_str, "run");
+
+    auto [my_int, extra] = layered.try_resolve(reader::num<int>("my_int"), reader::num<double>("extra")).value();
+    EXPECT_EQ(my_int, 7);
+    EXPECT_EQ(extra, 2.5);
+
+    auto bad = layered.push_overrides(std::array{"no delimiter"sv});
+    ASSERT_FALSE(bad.has_value());
+    EXPECT_EQ(bad.error().kind, ReaderError::Kind::ParseError);
+    EXPECT_EQ(layered.layer_count(), 3);
+}
+
+TEST(LayeredReaderTest, FlattenOutlivesTheLayers) 
+{
+    auto base = std::make_shared<const ParameterReader>(ParameterReader::build(file_name, "=>").value());
+    std::optional<ParameterReader> flat{};
+    {
+        reader::LayeredReader layered{base};
+        ASSERT_TRUE(layered.push_overrides(std::array{"my_int=7"sv}).has_value());
+        EXPECT_EQ(base.use_count(), 2); // shared, not copied
+        flat = layered.flatten();
+    }
+    base.reset();
+
+    ASSERT_TRUE(flat->is_frozen());
+    EXPECT_EQ(flat->try_parse_num<int>("my_int").value(), 7);
+    EXPECT_EQ(flat->try_get_str("my_str").value(), "hello world");
+    EXPECT_EQ(flat->try_parse_vector<float>("bad_vector", ",").error().args, "XXX, YYY, ?!+");
+}
+
+TEST(ParameterStreamTest, MatchesReaderWithTinyChunks) 
+{
+    auto parameters = reader::ParameterReader::build(file_name, "=>");
+    auto stream     = reader::ParameterStream::open(file_name, "=>", reader::Mode::Strict, 8);
+    ASSERT_TRUE(parameters.has_value());
+    ASSERT_TRUE(stream.has_value());
+
+    size_t records = 0;
+    for (const auto& record : stream.value())
+    {
+        ASSERT_TRUE(record.has_value());
+        EXPECT_EQ(record->value, parameters->try_get_str(record->key).value());
+        records++;
+    }
+    EXPECT_EQ(records, 11);
+}
+
+TEST(ParameterStreamTest, StrictAndPermissiveModes) 
+{
+    std::istringstream strict_input{"a => 1\nno delimiter here\nb => 2"};
+    std::vector<std::expected<std::string, ReaderError>> strict{}; // records are only valid until the next increment
+    for (const auto& record : reader::ParameterStream::from_istream(strict_input, "=>", reader::Mode::Strict, 4))
+    {
+        strict.push_back(record.transform([](const reader::KeyValue& kv){return std::string{kv.key};}));
+    }
+    ASSERT_EQ(strict.size(), 2);
+    EXPECT_EQ(strict[0].value(), "a");
+    ASSERT_FALSE(strict[1].has_value());
+    EXPECT_EQ(strict[1].error().args, "no delimiter here");
+
+    std::istringstream permissive_input{"a => 1\nno delimiter here\nb => 2\n"};
+    std::vector<std::string> keys{};
+    for (const auto& record : reader::ParameterStream::from_istream(permissive_input, "=>", reader::Mode::Permissive, 4))
+    {
+        keys.emplace_back(record->key);
+    }
+    EXPECT_EQ(keys, (std::vector<std::string>{"a", "b"}));
+}
+
+TEST(ParameterStreamTest, SectionsMatchTheReader) 
+{
+    constexpr str_v text = "a => 1\n[solver]\ntol => 1e-6\n[ io ]\npath => out\n[]\nb => 2\n";
+    auto parameters = ParameterReader::build_from_buffer(text, "=>");
+    ASSERT_TRUE(parameters.has_value());
+
+    std::istringstream input{std::string{text}};
+    std::vector<std::string> keys{};
+    for (const auto& record : reader::ParameterStream::from_istream(input, "=>", reader::Mode::Strict, 4))
+    {
+        ASSERT_TRUE(record.has_value());
+        EXPECT_EQ(record->value, parameters->try_get_str(record->key).value());
+        keys.emplace_back(record->key);
+    }
+    EXPECT_EQ(keys, (std::vector<std::string>{"a", "solver.tol", "io.path", "b"}));
+}
+
+class LargeFileTest : public testing::Test
+{
+protected:
+    std::filesystem::path path{test_temp_path("large.txt")};
+
+    auto write_lines(size_t count, const std::vector<std::pair<size_t, std::string>>& extra_lines) -> void
+    {
+        std::ofstream file{path};
+        for (size_t i = 0; i < count; i++)
+        {
+            for (const auto& [at, line] : extra_lines)
+            {
+                if (at == i)
+                {
+                    file << line << '\n';
+                }
+            }
+            file << "key_" << i << " => " << i << '\n';
+        }
+    }
+    ~LargeFileTest() override
+    {
+        std::filesystem::remove(path);
+    }
+};
+
+TEST_F(LargeFileTest, ParallelBuildMatchesSequential) 
+{
+    write_lines(200'000, {{10, "duplicate => first"}, {199'990, "duplicate => last"}});
+    auto sequential = reader::ParameterReader::build(path.string(), "=>");
+    auto parallel   = reader::ParameterReader::build_parallel(path.string(), "=>", 8);
+
+    ASSERT_TRUE(sequential.has_value());
+    ASSERT_TRUE(parallel.has_value());
+    EXPECT_EQ(parallel->try_get_str("duplicate").value(), "first");
+    for (size_t i = 0; i < 200'000; i += 997)
+    {
+        auto key = "key_" + std::to_string(i);
+        EXPECT_EQ(parallel->try_parse_num<size_t>(key).value(), i);
+    }
+    EXPECT_FALSE(parallel->try_get_str("key_200000").has_value());
+}
+
+TEST_F(LargeFileTest, ParallelBuildReportsEarliestError) 
+{
+    write_lines(200'000, {{150'000, "second bad line"}, {20'000, "first bad line"}});
+    auto parallel = reader::ParameterReader::build_parallel(path.string(), "=>", 8);
+
+    ASSERT_FALSE(parallel.has_value());
+    EXPECT_EQ(parallel.error().kind, ReaderError::Kind::ParseError);
+    EXPECT_EQ(parallel.error().args, "first bad line");
+    ASSERT_TRUE(parallel.error().location().has_value());
+    EXPECT_EQ(parallel.error().location()->line, 20'001);
+    EXPECT_EQ(parallel.error().location()->column, 1);
+}
+
+TEST_F(ReaderTest, ParseCacheMemoizesPerTypeAndDelimiter) 
+{
+    reader::ParseCache cache{*reader};
+
+    auto first  = cache.try_parse_vector<float>("good_vector", ",");
+    auto second = cache.try_parse_vector<float>("good_vector", ",");
+    ASSERT_TRUE(first.has_value());
+    ASSERT_TRUE(second.has_value());
+    EXPECT_EQ(first->data(), second->data()) << "second call should hit the cache";
+    EXPECT_TRUE(std::ranges::equal(first.value(), good_vec_res.value()));
+
+    EXPECT_EQ(cache.try_parse_num<int>("my_int").value(), 42);
+    EXPECT_EQ(cache.try_parse_num<double>("my_int").value(), 42.0);
+    EXPECT_EQ(cache.try_parse_vector<double>("good_vector", ",")->size(), 10);
+    EXPECT_EQ(cache.size(), 4);
+
+    auto missing = cache.try_parse_num<float>("non-existing float");
+    ASSERT_FALSE(missing.has_value());
+    EXPECT_EQ(missing.error().kind, ReaderError::Kind::KeyError);
+    EXPECT_EQ(cache.try_parse_vector<float>("bad_vector", ",").error().args, "XXX, YYY, ?!+");
+    EXPECT_EQ(cache.size(), 4) << "errors are not cached";
+
+    cache.clear();
+    EXPECT_EQ(cache.size(), 0);
+}
+
+class ReloadTest : public testing::Test
+{
+protected:
+    std::filesystem::path path{test_temp_path("reload.txt")};
+
+    auto write(const std::string& content) -> void
+    {
+        std::ofstream file{path, std::ios::trunc};
+        file << content;
+    }
+    template<typename Predicate>
+    static auto wait_for(Predicate&& done) -> bool
+    {
+        for (int i = 0; i < 500 && !done(); i++)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds{10});
+        }
+        return done();
+    }
+    ~ReloadTest() override
+    {
+        std::filesystem::remove(path);
+    }
+};
+
+TEST_F(ReloadTest, ManualReloadKeepsOldSnapshotOnError) 
+{
+    write("tolerance => 0.5\n");
+    auto reloadable = reader::ReloadableReader::open(path.string(), "=>");
+    ASSERT_TRUE(reloadable.has_value());
+    auto& handle = *reloadable.value();
+    auto before  = handle.snapshot();
+    auto local   = handle.local_snapshot();
+
+    write("tolerance => 0.25\n");
+    ASSERT_TRUE(handle.reload().has_value());
+    EXPECT_EQ(local.get().try_parse_num<double>("tolerance").value(), 0.25);
+    EXPECT_EQ(before->try_parse_num<double>("tolerance").value(), 0.5) << "old snapshots stay valid";
+
+    write("tolerance => 0.125\nnot a parameter line\n");
+    auto failed = handle.reload();
+    ASSERT_FALSE(failed.has_value());
+    EXPECT_EQ(failed.error().args, "not a parameter line");
+    EXPECT_EQ(handle.last_error()->kind, ReaderError::Kind::ParseError);
+    EXPECT_EQ(local.get().try_parse_num<double>("tolerance").value(), 0.25);
+
+    write("tolerance => 0.125\n");
+    ASSERT_TRUE(handle.reload().has_value());
+    EXPECT_FALSE(handle.last_error().has_value());
+}
+
+TEST_F(ReloadTest, WatcherPicksUpChanges) 
+{
+    write("tolerance => 0.5\n");
+    auto reloadable = reader::ReloadableReader::open(path.string(), "=>", reader::Mode::Strict, std::chrono::milliseconds{10});
+    ASSERT_TRUE(reloadable.has_value());
+    auto& handle = *reloadable.value();
+    std::this_thread::sleep_for(std::chrono::milliseconds{50}); // let the watcher start
+    uint64_t generation = handle.generation();
+
+    write("tolerance => 0.25\n");
+    ASSERT_TRUE(wait_for([&]{return handle.generation() > generation;}));
+    EXPECT_EQ(handle.snapshot()->try_parse_num<double>("tolerance").value(), 0.25);
+}
+
+TEST_F(ReaderTest, ResolveBatch) 
+{
+    auto resolved = reader->try_resolve(reader::num<int>("my_int"), reader::vec<float>("good_vector", ","), reader::str("my_str"), reader::vec<int>("int_list", "and"));
+
+    ASSERT_TRUE(resolved.has_value());
+    auto [my_int, good_vector, my_str, int_list] = resolved.value();
+    EXPECT_EQ(my_int, 42);
+    EXPECT_EQ(good_vector, good_vec_res.value());
+    EXPECT_EQ(my_str, "hello world");
+    EXPECT_EQ(int_list, (Vec<int>{1, 2, 3}));
+}
+
+TEST_F(ReaderTest, ResolveBatchReportsEveryError) 
+{
+    auto resolved = reader->try_resolve(reader::num<float>("my_bad_float"), reader::num<int>("my_int"), reader::str("non-existing str"), reader::vec<float>("bad_vector", ","));
+
+    ASSERT_FALSE(resolved.has_value());
+    ASSERT_EQ(resolved.error().size(), 3);
+    EXPECT_EQ(resolved.error()[0].args, "my_bad_float: meow");
+    EXPECT_EQ(resolved.error()[0].kind, ReaderError::Kind::ParseError);
+    EXPECT_EQ(resolved.error()[1].args, "non-existing str");
+    EXPECT_EQ(resolved.error()[1].kind, ReaderError::Kind::KeyError);
+    EXPECT_EQ(resolved.error()[2].args, "bad_vector: XXX, YYY, ?!+");
+    EXPECT_EQ(resolved.error()[2].from, ReaderError::From::try_resolve);
+
+    EXPECT_DEATH(reader->resolve_or_exit(reader::num<float>("my_bad_float"), reader::str("non-existing str")),
+                "from: \"resolve_or_exit\".*\n.*Exiting with 2 ParameterParserError");
+}
+
+#ifdef PARAMETER_PARSER_INSTRUMENTATION
+TEST(InstrumentationTest, CountsHitsMissesAndUnusedKeys) 
+{
+    auto built = reader::ParameterReader::build(file_name, "=>");
+    ASSERT_TRUE(built.has_value());
+    EXPECT_TRUE(built->try_parse_num<int>("my_int").has_value());
+    EXPECT_TRUE(built->try_parse_num<long>("my_int").has_value());
+    EXPECT_TRUE(built->try_parse_vector<float>("good_vector", ",").has_value());
+    EXPECT_FALSE(built->try_get_str("my_strr").has_value());
+
+    const auto& stats = built->access_stats();
+    auto keys         = stats.keys();
+    auto my_int       = std::ranges::find(keys, "my_int"sv, &reader::AccessStats::KeyStats::key);
+    ASSERT_NE(my_int, keys.end());
+    EXPECT_EQ(my_int->hits[static_cast<size_t>(reader::Access::try_parse_num)], 2);
+    EXPECT_EQ(my_int->parsed_bytes, 4);
+
+    auto unused = stats.never_accessed();
+    EXPECT_NE(std::ranges::find(unused, "my_double"sv), unused.end());
+    EXPECT_EQ(std::ranges::find(unused, "good_vector"sv), unused.end());
+    ASSERT_EQ(stats.misses().size(), 1);
+    EXPECT_EQ(stats.misses()[0].key, "my_strr");
+
+    std::ostringstream report{};
+    stats.write_report(report);
+    EXPECT_NE(report.str().find("my_strr: try_get_str=1"), std::string::npos);
+}
+#endif
+
+class BinaryCacheTest : public testing::Test
+{
+protected:
+    std::filesystem::path source{test_temp_path("source.txt")};
+    std::filesystem::path cache{test_temp_path("cache.bin")};
+
+    auto write_source(const std::string& content) -> void
+    {
+        std::ofstream file{source, std::ios::trunc};
+        file << content;
+    }
+    ~BinaryCacheTest() override
+    {
+        std::filesystem::remove(source);
+        std::filesystem::remove(cache);
+    }
+};
+
+TEST_F(BinaryCacheTest, LoadsValidCacheAndRebuildsStaleOne) 
+{
+    write_source("my_int => 42\nmy_vec => 1, 2, 3\n");
+    auto built = reader::BinaryCache::build(source.string(), cache.string(), "=>");
+    ASSERT_TRUE(built.has_value());
+    ASSERT_TRUE(std::filesystem::exists(cache));
+
+    // Same size and mtime but different bytes: only a full check notices
+    auto mtime = std::filesystem::last_write_time(source);
+    write_source("my_int => 43\nmy_vec => 1, 2, 3\n");
+    std::filesystem::last_write_time(source, mtime);
+
+    auto cached = reader::BinaryCache::build(source.string(), cache.string(), "=>");
+    ASSERT_TRUE(cached.has_value());
+    EXPECT_EQ(cached->try_parse_num<int>("my_int").value(), 42);
+    EXPECT_EQ(cached->try_parse_vector<int>("my_vec", ",").value(), (Vec<int>{1, 2, 3}));
+
+    auto checked = reader::BinaryCache::build(source.string(), cache.string(), "=>", reader::Mode::Strict, reader::CacheCheck::Full);
+    ASSERT_TRUE(checked.has_value());
+    EXPECT_EQ(checked->try_parse_num<int>("my_int").value(), 43);
+
+    auto other_delimiter = reader::BinaryCache::build(source.string(), cache.string(), "my_");
+    ASSERT_TRUE(other_delimiter.has_value());
+    EXPECT_FALSE(other_delimiter->try_parse_num<int>("my_int").has_value());
+}
+
+TEST_F(BinaryCacheTest, SourceErrorsAreReturned) 
+{
+    write_source("my_int => 42\nbad line\n");
+    auto built = reader::BinaryCache::build(source.string(), cache.string(), "=>");
+
+    ASSERT_FALSE(built.has_value());
+    EXPECT_EQ(built.error().args, "bad line");
+    EXPECT_FALSE(std::filesystem::exists(cache));
+}
+
+TEST_F(BinaryCacheTest, CorruptedCacheIsRebuilt) 
+{
+    write_source("my_int => 42\n");
+    ASSERT_TRUE(reader::BinaryCache::build(source.string(), cache.string(), "=>").has_value());
+    {
+        // the first entry's key_offset, right after the 48 byte header: offset + length wraps around to a small number
+        std::fstream file{cache, std::ios::in | std::ios::out | std::ios::binary};
+        file.seekp(48);
+        uint64_t key_offset = std::numeric_limits<uint64_t>::max() - 1;
+        file.write(reinterpret_cast<const char*>(&key_offset), sizeof(key_offset));
+    }
+    auto rebuilt = reader::BinaryCache::build(source.string(), cache.string(), "=>");
+    ASSERT_TRUE(rebuilt.has_value());
+    EXPECT_EQ(rebuilt->try_parse_num<int>("my_int").value(), 42);
+}
+
+TEST_F(BinaryCacheTest, WriteRefusesReadersItCannotDescribe) 
+{
+    write_source("my_int => 42\n");
+    auto stamp = reader::BinaryCache::stamp(source.string());
+    ASSERT_TRUE(stamp.has_value());
+    auto built = reader::BinaryCache::build(source.string(), cache.string(), "=>");
+    ASSERT_TRUE(built.has_value());
+
+    auto cached = reader::BinaryCache::build(source.string(), cache.string(), "=>"); // values point into the cache
+    ASSERT_TRUE(cached.has_value());
+    EXPECT_FALSE(reader::BinaryCache::write(cached.value(), stamp.value(), cache.string(), "=>", reader::Mode::Strict).has_value());
+
+    write_source("my_int => 4242\n"); // changed after the stamp was taken
+    auto rebuilt = reader::ParameterReader::build(source.string(), "=>");
+    ASSERT_TRUE(rebuilt.has_value());
+    EXPECT_FALSE(reader::BinaryCache::write(rebuilt.value(), stamp.value(), cache.string(), "=>", reader::Mode::Strict).has_value());
+    EXPECT_TRUE(reader::BinaryCache::write(built.value(), stamp.value(), cache.string(), "=>", reader::Mode::Strict).has_value());
+}